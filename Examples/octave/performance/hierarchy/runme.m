@@ -0,0 +1,28 @@
+# do not dump Octave core
+if exist("crash_dumps_octave_core", "builtin")
+  crash_dumps_octave_core(0);
+endif
+
+# Method call throughput on an eight level deep class hierarchy.
+# H.func is inherited from the root class A, so every call looks the
+# method up through all the bases.
+
+Simple
+
+n = 100000;
+
+a = Simple.A();
+tic;
+for i = 1:n
+  a.func();
+endfor
+t = toc;
+printf("A.func (declared in class)  : %d calls in %f seconds, %.0f calls/s\n", n, t, n / t);
+
+h = Simple.H();
+tic;
+for i = 1:n
+  h.func();
+endfor
+t = toc;
+printf("H.func (inherited 7 levels) : %d calls in %f seconds, %.0f calls/s\n", n, t, n / t);
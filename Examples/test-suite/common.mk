@@ -556,6 +556,7 @@ CPP_TEST_CASES += \
 	varargs \
 	varargs_overload \
 	variable_replacement \
+	virtual_base_specifier \
 	virtual_destructor \
 	virtual_derivation \
 	virtual_poly \
@@ -0,0 +1,60 @@
+using System;
+using csharp_blittableNamespace;
+
+public class runme
+{
+  static void Main()
+  {
+    Vec2 v = csharp_blittable.makeVec2(3, 4);
+    if (v.x != 3 || v.y != 4)
+      throw new Exception("makeVec2 failed");
+
+    if (csharp_blittable.dot(v, v) != 25)
+      throw new Exception("dot failed");
+
+    csharp_blittable.scale(ref v, 2);
+    if (v.x != 6 || v.y != 8)
+      throw new Exception("scale failed");
+
+    csharp_blittable.translate(ref v, 1, 1);
+    if (v.x != 7 || v.y != 9)
+      throw new Exception("translate failed");
+
+    Triangle t = csharp_blittable.makeTriangle(42);
+    if (t.id != 42 || t.b.x != 1 || t.c.y != 1)
+      throw new Exception("makeTriangle failed");
+    unsafe {
+      if (t.weights[0] != 0.5f || t.weights[2] != 0.25f)
+        throw new Exception("makeTriangle weights failed");
+    }
+
+    Flags f = csharp_blittable.makeFlags('x', -2, 200);
+    if (f.tag != (sbyte)'x' || f.delta != -2 || f.mask != 200)
+      throw new Exception("makeFlags failed");
+
+    using (Mesh m = new Mesh()) {
+      m.origin = v;
+      if (m.origin.x != 7 || m.origin.y != 9)
+        throw new Exception("Mesh.origin failed");
+      Vec2 anchor = m.anchor;
+      if (anchor.x != 0 || anchor.y != 0)
+        throw new Exception("null Mesh.anchor failed");
+    }
+
+    Vec2[] points = { csharp_blittable.makeVec2(3, 4), csharp_blittable.makeVec2(6, 8), csharp_blittable.makeVec2(5, 12) };
+    Span<double> lengths = stackalloc double[points.Length];
+    csharp_blittable.pathLengths(points, lengths, points.Length);
+    if (lengths[0] != 5 || lengths[1] != 10 || lengths[2] != 13)
+      throw new Exception("pathLengths failed");
+
+    using (Vec2Vector vec = new Vec2Vector()) {
+      vec.CopyFrom(points);
+      if (vec.Count != 3)
+        throw new Exception("CopyFrom failed");
+      Span<Vec2> span = vec.AsSpan();
+      span[1].x = 100;
+      if (csharp_blittable.sumX(vec) != 108)
+        throw new Exception("AsSpan failed");
+    }
+  }
+}
@@ -0,0 +1,36 @@
+using System;
+using csharp_fastcallNamespace;
+
+public class runme {
+  static void Main() {
+    if (csharp_fastcall.addInts(2, 3) != 5)
+      throw new Exception("addInts failed");
+
+    if (csharp_fastcall.scale(1.5, 2.0) != 3.0)
+      throw new Exception("scale failed");
+
+    if (csharp_fastcall.greeting() != "hello")
+      throw new Exception("greeting failed");
+
+    if (csharp_fastcall.checkedDivide(9, 3) != 3)
+      throw new Exception("checkedDivide failed");
+
+    try {
+      csharp_fastcall.checkedDivide(1, 0);
+      throw new Exception("checkedDivide did not throw");
+    } catch (ArgumentException e) {
+      if (!e.Message.Contains("division by zero"))
+        throw new Exception("checkedDivide wrong message: " + e.Message);
+    }
+
+    Counter c = new Counter();
+    for (int i = 0; i < 10; i++)
+      c.increment();
+    if (c.count != 10)
+      throw new Exception("Counter.count failed: " + c.count);
+    c.count = 42;
+    c.value = 0.5;
+    if (c.count != 42 || c.value != 0.5)
+      throw new Exception("Counter setters failed");
+  }
+}
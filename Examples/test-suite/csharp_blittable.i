@@ -0,0 +1,99 @@
+%module csharp_blittable
+
+%include "arrays_csharp.i"
+%include "std_vector.i"
+
+%csblittable(Vec2)
+%csblittable(Triangle)
+%csblittable(Flags)
+
+%inline %{
+struct Vec2 {
+  double x;
+  double y;
+};
+
+struct Triangle {
+  Vec2 a, b, c;
+  float weights[3];
+  int id;
+};
+
+struct Mesh {
+  Vec2 origin;
+  Vec2 *anchor;
+  Mesh() : anchor(0) {}
+};
+
+Vec2 makeVec2(double x, double y) {
+  Vec2 v;
+  v.x = x;
+  v.y = y;
+  return v;
+}
+
+double dot(const Vec2 &a, const Vec2 &b) {
+  return a.x*b.x + a.y*b.y;
+}
+
+void scale(Vec2 *v, double factor) {
+  v->x *= factor;
+  v->y *= factor;
+}
+
+void translate(Vec2 &v, double dx, double dy) {
+  v.x += dx;
+  v.y += dy;
+}
+
+struct Flags {
+  char tag;
+  signed char delta;
+  unsigned char mask;
+};
+
+Flags makeFlags(char tag, int delta, int mask) {
+  Flags f;
+  f.tag = tag;
+  f.delta = (signed char)delta;
+  f.mask = (unsigned char)mask;
+  return f;
+}
+
+Triangle makeTriangle(int id) {
+  Triangle t;
+  t.a = makeVec2(0, 0);
+  t.b = makeVec2(1, 0);
+  t.c = makeVec2(0, 1);
+  t.weights[0] = 0.5f;
+  t.weights[1] = 0.25f;
+  t.weights[2] = 0.25f;
+  t.id = id;
+  return t;
+}
+%}
+
+CSHARP_SPAN(Vec2, Vec2)
+%apply Vec2 READONLYSPAN[] { const Vec2 *points }
+%apply double SPAN[] { double *lengths }
+%csmethodmodifiers pathLengths "public unsafe";
+
+%inline %{
+#include <math.h>
+void pathLengths(const Vec2 *points, double *lengths, int count) {
+  for (int i = 0; i < count; ++i)
+    lengths[i] = sqrt(dot(points[i], points[i]));
+}
+%}
+
+SWIG_STD_VECTOR_BLITTABLE(Vec2)
+%template(Vec2Vector) std::vector<Vec2>;
+
+%inline %{
+double sumX(const std::vector<Vec2> &v) {
+  double sum = 0;
+  for (size_t i = 0; i < v.size(); ++i)
+    sum += v[i].x;
+  return sum;
+}
+%}
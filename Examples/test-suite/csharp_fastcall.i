@@ -0,0 +1,40 @@
+/* Test %cssuppressgctransition and %csfunctionpointer, the C# test also uses -DSWIG_CSHARP_UNMANAGED_CALLBACKS */
+%module csharp_fastcall
+
+%warnfilter(SWIGWARN_CSHARP_FASTCALL_IGNORED) checkedDivide;
+%warnfilter(SWIGWARN_CSHARP_FASTCALL_IGNORED) greeting;
+
+%include <std_except.i>
+
+%cssuppressgctransition addInts;
+%cssuppressgctransition Counter::count;
+%cssuppressgctransition Counter::increment;
+%cssuppressgctransition checkedDivide;
+%csfunctionpointer addInts;
+%csfunctionpointer scale;
+%csfunctionpointer Counter::count;
+%csfunctionpointer Counter::increment;
+%csfunctionpointer Counter::value;
+%csfunctionpointer greeting;
+
+%catches(std::invalid_argument) checkedDivide;
+
+%inline %{
+#include <stdexcept>
+
+int addInts(int a, int b) { return a + b; }
+double scale(double value, double factor) { return value * factor; }
+int checkedDivide(int a, int b) {
+  if (b == 0)
+    throw std::invalid_argument("division by zero");
+  return a / b;
+}
+const char *greeting() { return "hello"; }
+
+struct Counter {
+  int count;
+  double value;
+  Counter() : count(0), value(0.0) {}
+  void increment() { ++count; }
+};
+%}
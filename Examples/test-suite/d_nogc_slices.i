@@ -0,0 +1,68 @@
+%module d_nogc_slices
+
+%include <std_vector.i>
+
+%ignore Buffer::data;
+
+// The dnogc feature and the slice typemaps are only available for D2.
+#if SWIG_D_VERSION > 1
+%dnogc gain;
+%dnogc sum;
+%dnogc deviceName;
+%dnogc vectorSum;
+%dnogc Buffer::size;
+%dnogc Buffer::storage;
+%dnogc Buffer::values;
+
+%apply (float *SLICE, size_t LENGTH) { (float *samples, size_t count) }
+%apply (const double *SLICE, int LENGTH) { (const double *values, int n) }
+%apply const char *VIEW { const char *deviceName };
+%apply const std::vector<int> &SLICE { const std::vector<int> & };
+%apply std::vector<int> &SLICE { std::vector<int> &storage };
+
+// The proxy functions of these allocate GC memory, so %dnogc is ignored.
+%warnfilter(SWIGWARN_D_NOGC_IGNORED) makeBuffer;
+%warnfilter(SWIGWARN_D_NOGC_IGNORED) greeting;
+%warnfilter(SWIGWARN_D_NOGC_IGNORED) nameLength;
+%dnogc makeBuffer;
+%dnogc greeting;
+%dnogc nameLength;
+#endif
+
+%inline %{
+#include <string.h>
+#include <vector>
+
+void gain(float *samples, size_t count, float factor) {
+  for (size_t i = 0; i < count; ++i)
+    samples[i] *= factor;
+}
+
+double sum(const double *values, int n) {
+  double total = 0;
+  for (int i = 0; i < n; ++i)
+    total += values[i];
+  return total;
+}
+
+const char *deviceName() { return "default"; }
+
+int vectorSum(const std::vector<int> &v) {
+  int total = 0;
+  for (size_t i = 0; i < v.size(); ++i)
+    total += v[i];
+  return total;
+}
+
+struct Buffer {
+  std::vector<int> data;
+  Buffer() : data(4, 1) {}
+  int size() const { return (int)data.size(); }
+  std::vector<int> &storage() { return data; }
+  const std::vector<int> &values() const { return data; }
+};
+
+Buffer makeBuffer() { return Buffer(); }
+const char *greeting() { return "hello"; }
+int nameLength(const char *name) { return (int)strlen(name); }
+%}
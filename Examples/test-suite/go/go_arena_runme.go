@@ -0,0 +1,62 @@
+package main
+
+import "swigtests/go_arena"
+
+func main() {
+	a := go_arena.NewSwigArena()
+	defer go_arena.DeleteSwigArena(a)
+
+	for i := 0; i < 10000; i++ {
+		c := go_arena.NewCountedInArena(a, i)
+		if c.GetValue() != i {
+			panic(c.GetValue())
+		}
+	}
+	if go_arena.LiveCount() != 10000 {
+		panic(go_arena.LiveCount())
+	}
+	if a.Allocated() == 0 {
+		panic(a.Allocated())
+	}
+
+	if c := go_arena.NewCountedInArena(a); c.GetValue() != 0 {
+		panic(c.GetValue())
+	}
+	if c := go_arena.NewCountedInArena(a, 2, 3); c.GetValue() != 5 {
+		panic(c.GetValue())
+	}
+
+	p := go_arena.NewPairInArena(a, 1.5, 2)
+	if p.Sum() != 3.5 {
+		panic(p.Sum())
+	}
+
+	n := go_arena.NewNamedInArena(a, 7)
+	if n.GetId() != 7 {
+		panic(n.GetId())
+	}
+
+	// Reset runs all the destructors and keeps the arena usable.
+	a.Reset()
+	if go_arena.LiveCount() != 0 {
+		panic(go_arena.LiveCount())
+	}
+	if a.Allocated() != 0 {
+		panic(a.Allocated())
+	}
+
+	go_arena.NewCountedInArena(a, 1)
+	b := go_arena.NewSwigArena()
+	go_arena.NewCountedInArena(b, 2)
+	if go_arena.LiveCount() != 2 {
+		panic(go_arena.LiveCount())
+	}
+	go_arena.DeleteSwigArena(b)
+	if go_arena.LiveCount() != 1 {
+		panic(go_arena.LiveCount())
+	}
+
+	// Ordinary construction is unchanged.
+	c := go_arena.NewCounted(3)
+	go_arena.DeleteCounted(c)
+}
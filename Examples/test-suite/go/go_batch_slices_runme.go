@@ -0,0 +1,62 @@
+package main
+
+import "swigtests/go_batch_slices"
+
+func main() {
+	var sb go_batch_slices.ScaledBatch
+	for i := 0; i < 100; i++ {
+		sb.Add(i, 0.5)
+	}
+	if sb.Len() != 100 {
+		panic(sb.Len())
+	}
+	sb.Run()
+	if sb.Len() != 0 {
+		panic(sb.Len())
+	}
+	for i := 0; i < 100; i++ {
+		if sb.Result(i) != float64(i)*0.5 {
+			panic(sb.Result(i))
+		}
+	}
+
+	var cb go_batch_slices.CountBatch
+	for i := 0; i < 10; i++ {
+		cb.Add()
+	}
+	cb.Run()
+	if go_batch_slices.Counted() != 10 {
+		panic(go_batch_slices.Counted())
+	}
+
+	a := go_batch_slices.NewAccumulator()
+	defer go_batch_slices.DeleteAccumulator(a)
+	var ab go_batch_slices.AccumulatorAddBatch
+	for i := 1; i <= 4; i++ {
+		ab.Add(a, float64(i))
+	}
+	ab.Run()
+	if a.GetTotal() != 10 {
+		panic(a.GetTotal())
+	}
+
+	var selfb go_batch_slices.AccumulatorSelfBatch
+	selfb.Add(a)
+	selfb.Run()
+	if selfb.Result(0).Swigcptr() != a.Swigcptr() {
+		panic("AccumulatorSelfBatch")
+	}
+
+	if s := go_batch_slices.Sum([]float64{1, 2, 3.5}); s != 6.5 {
+		panic(s)
+	}
+	if s := go_batch_slices.Sum(nil); s != 0 {
+		panic(s)
+	}
+
+	v := []int32{1, 2, 3}
+	go_batch_slices.Twice(v)
+	if v[0] != 2 || v[1] != 4 || v[2] != 6 {
+		panic(v)
+	}
+}
@@ -0,0 +1,34 @@
+// Test the goarena feature
+%module go_arena
+
+%include <goarena.i>
+
+%goarena Counted;
+%goarena Pair;
+%goarena Named::Named(int);
+
+%inline %{
+static int live = 0;
+
+struct Counted {
+  int value;
+  Counted() : value(0) { ++live; }
+  Counted(int v) : value(v) { ++live; }
+  Counted(int a, int b) : value(a + b) { ++live; }
+  ~Counted() { --live; }
+};
+
+struct Pair {
+  double first, second;
+  Pair(double f, double s) : first(f), second(s) {}
+  double sum() const { return first + second; }
+};
+
+struct Named {
+  int id;
+  Named() : id(-1) {}
+  Named(int i) : id(i) {}
+};
+
+int liveCount() { return live; }
+%}
@@ -0,0 +1,39 @@
+// Test the gobatch feature and the (TYPE *SLICE, size_t LENGTH) typemaps
+%module go_batch_slices
+
+%gobatch scaled;
+%gobatch count;
+%gobatch Accumulator::add;
+%gobatch Accumulator::self;
+
+%apply (double *SLICE, size_t LENGTH) { (const double *values, size_t n) }
+%apply (int *SLICE, int LENGTH) { (int *values, int n) }
+
+%inline %{
+#include <stddef.h>
+
+static int counter = 0;
+
+double scaled(int value, double factor) { return value * factor; }
+void count() { ++counter; }
+int counted() { return counter; }
+
+struct Accumulator {
+  double total;
+  Accumulator() : total(0) {}
+  void add(double value) { total += value; }
+  Accumulator *self() { return this; }
+};
+
+double sum(const double *values, size_t n) {
+  double total = 0;
+  for (size_t i = 0; i < n; ++i)
+    total += values[i];
+  return total;
+}
+
+void twice(int *values, int n) {
+  for (int i = 0; i < n; ++i)
+    values[i] *= 2;
+}
+%}
@@ -0,0 +1,34 @@
+;; The SWIG modules have "passive" Linkage, i.e., they don't generate
+;; Guile modules (namespaces) but simply put all the bindings into the
+;; current module.  That's enough for such a simple test.
+(dynamic-call "scm_init_uniform_vector_module" (dynamic-link "./libuniform_vector"))
+
+(use-modules (srfi srfi-4))
+
+(define-macro (check-equality form1 form2)
+  `(let ((result1 ,form1)
+	 (result2 ,form2))
+     (if (not (equal? result1 result2))
+	 (error "Check failed:"
+		(list 'equal? ',form1 ',form2)
+		result1 result2))))
+
+;; The C function writes to the storage of the vector.
+(define v (f64vector 1.0 2.0 3.0))
+(scale v 2.0)
+(check-equality v #f64(2.0 4.0 6.0))
+
+(check-equality (sum-ints #s32(1 2 3 4)) 10)
+(check-equality (ramp) #f32(0.0 1.0 2.0 3.0))
+(check-equality (squares #f64(1.0 2.0 3.0)) #f64(1.0 4.0 9.0))
+(check-equality (squares #f64()) #f64())
+
+(define p (make-point 3 4))
+(check-equality (Point-x-get p) 3)
+(check-equality (Point-y-get p) 4)
+(Point-x-set p 5)
+(check-equality (Point-x-get p) 5)
+(set! p #f)
+(gc)
+
+(exit 0)
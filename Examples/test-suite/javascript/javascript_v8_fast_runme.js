@@ -0,0 +1,43 @@
+var javascript_v8_fast = require("javascript_v8_fast");
+
+var d = new javascript_v8_fast.FastDerived();
+if (d.get() != 2) {
+  throw new Error("Failed.");
+}
+if (javascript_v8_fast.getValue(d) != 2) {
+  throw new Error("Failed.");
+}
+
+// objects returned from C++ use the cached instance template
+var b = javascript_v8_fast.makeDerived();
+if (b.get() != 2 || !(b instanceof Object)) {
+  throw new Error("Failed.");
+}
+if (javascript_v8_fast.getValue(b) != 2) {
+  throw new Error("Failed.");
+}
+
+if (javascript_v8_fast.addInts(2, 3) != 5) {
+  throw new Error("Failed.");
+}
+
+// wrong receiver and wrong argument type must still be rejected
+var thrown = false;
+try {
+  javascript_v8_fast.FastBase.prototype.get.call(new javascript_v8_fast.FastOther());
+} catch (e) {
+  thrown = true;
+}
+if (!thrown) {
+  throw new Error("Failed: receiver not checked.");
+}
+
+thrown = false;
+try {
+  javascript_v8_fast.getValue(new javascript_v8_fast.FastOther());
+} catch (e) {
+  thrown = true;
+}
+if (!thrown) {
+  throw new Error("Failed: argument not checked.");
+}
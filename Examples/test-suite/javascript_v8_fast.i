@@ -0,0 +1,29 @@
+/* Test the faster V8 object model selected by SWIGV8_FAST, other engines ignore the macro */
+%module javascript_v8_fast
+
+%begin %{
+#define SWIGV8_FAST
+%}
+
+%newobject makeDerived;
+
+%inline %{
+struct FastBase {
+  int value;
+  FastBase() : value(1) {}
+  virtual ~FastBase() {}
+  int get() const { return value; }
+};
+
+struct FastDerived : FastBase {
+  FastDerived() { value = 2; }
+};
+
+struct FastOther {
+  int other;
+};
+
+FastBase *makeDerived() { return new FastDerived(); }
+int getValue(const FastBase *b) { return b->get(); }
+int addInts(int a, int b) { return a + b; }
+%}
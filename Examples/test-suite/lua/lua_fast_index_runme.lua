@@ -0,0 +1,31 @@
+require("import")	-- the import fn
+import("lua_fast_index")	-- import lib
+
+local t = lua_fast_index;
+local l1 = t.Level1()
+local l6 = t.Level6()
+
+-- methods and attributes inherited from every level
+assert(l6:level() == 5)
+assert(l6:depth() == 6)
+assert(l6.value1 == 1)
+assert(l6.value2 == 2)
+assert(l6.value4 == 4)
+assert(l6.name1 == 6)
+assert(l1:name1() == "Level1")
+
+-- setters still work and getters see the new values
+l6.value1 = 10
+assert(l6.value1 == 10)
+l6.name1 = 60
+assert(l6.name1 == 60)
+
+-- unknown keys fall back to __getitem
+assert(l6.unknown == "unknown")
+
+-- methods added at runtime are still found
+getmetatable(l6)[".fn"].extra = function(self) return "extra" end
+assert(l6:extra() == "extra")
+
+-- the flattened lookup table is in place
+assert(getmetatable(l6)[".index"] ~= nil)
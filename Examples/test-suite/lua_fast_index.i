@@ -0,0 +1,47 @@
+/* Test the -fast-index option, the Lua test-suite wraps this module with it */
+%module lua_fast_index
+
+%inline %{
+class Level1 {
+public:
+  int value1;
+  Level1() : value1(1) {}
+  virtual ~Level1() {}
+  int level() const { return 1; }
+  const char *name1() const { return "Level1"; }
+  virtual int depth() const { return 1; }
+};
+
+class Level2 : public Level1 {
+public:
+  int value2;
+  Level2() : value2(2) {}
+  int level() const { return 2; }
+  virtual int depth() const { return 2; }
+};
+
+class Level3 : public Level2 {
+public:
+  int level() const { return 3; }
+};
+
+class Level4 : public Level3 {
+public:
+  int value4;
+  Level4() : value4(4) {}
+};
+
+class Level5 : public Level4 {
+public:
+  int level() const { return 5; }
+};
+
+class Level6 : public Level5 {
+public:
+  /* an attribute hiding a method of the same name */
+  int name1;
+  Level6() : name1(6) {}
+  virtual int depth() const { return 6; }
+  const char *__getitem(const char *key) const { return key; }
+};
+%}
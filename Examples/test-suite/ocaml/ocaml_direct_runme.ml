@@ -0,0 +1,25 @@
+open Swig
+open Ocaml_direct
+
+let _ =
+  assert (_scale_direct 1.5 2. = 3.);
+  assert (_add_direct 40 2 = 42);
+  assert (_negative_direct (-1));
+  assert (not (_negative_direct 1));
+  assert (_answer_direct () = 42);
+  let a = Bigarray.Array1.of_array Bigarray.float64 Bigarray.c_layout [| 1.; 2.; 3. |] in
+  assert (_sum_direct a = 6.);
+  let b = Bigarray.Array1.create Bigarray.float32 Bigarray.c_layout 4 in
+  _fill_direct b;
+  assert (b.{3} = 3.);
+  let r = _ramp_direct 5 in
+  assert (Bigarray.Array1.dim r = 5);
+  assert (r.{4} = 4.);
+  let s = _shared_direct () in
+  s.{0} <- 5.;
+  assert ((_shared_direct ()).{0} = 5.);
+  let c = _constant_direct () in
+  assert (Bigarray.Array1.dim c = 2);
+  assert (c.{1} = 7.);
+  assert (_add '(1, 2) as int = 3);
+;;
@@ -0,0 +1,57 @@
+%module ocaml_direct
+
+%include <bigarray.i>
+
+%ocamlnoalloc scale;
+%ocamldirect add;
+%ocamldirect negative;
+%ocamldirect answer;
+%ocamldirect sum;
+%ocamldirect fill;
+%ocamldirect ramp;
+%ocamldirect shared;
+%ocamlnoalloc constant;
+
+%apply (const double *BIGARRAY, int LENGTH) { (const double *data, int n) };
+%apply (int LENGTH, float *BIGARRAY) { (int n, float *data) };
+%apply std::vector<double> BIGARRAY { std::vector<double> ramp };
+%apply std::vector<double> &BIGARRAY { std::vector<double> &shared };
+%apply const std::vector<double> &BIGARRAY { const std::vector<double> &constant };
+
+%inline %{
+#include <vector>
+
+double scale(double x, double factor) { return x * factor; }
+int add(int a, int b) { return a + b; }
+bool negative(long x) { return x < 0; }
+int answer() { return 42; }
+
+double sum(const double *data, int n) {
+  double total = 0;
+  for (int i = 0; i < n; i++)
+    total += data[i];
+  return total;
+}
+
+void fill(int n, float *data) {
+  for (int i = 0; i < n; i++)
+    data[i] = (float)i;
+}
+
+std::vector<double> ramp(int n) {
+  std::vector<double> v;
+  for (int i = 0; i < n; i++)
+    v.push_back(i);
+  return v;
+}
+
+std::vector<double> &shared() {
+  static std::vector<double> v(3, 1.0);
+  return v;
+}
+
+const std::vector<double> &constant() {
+  static const std::vector<double> v(2, 7.0);
+  return v;
+}
+%}
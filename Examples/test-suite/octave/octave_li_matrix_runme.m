@@ -0,0 +1,64 @@
+octave_li_matrix
+
+m = [0 1 2; 3 4 5];
+
+% Column-major input is passed without conversion
+if (inDoubleMatrixDims(m, 1, 2) != 5)
+  error("bad inDoubleMatrixDims");
+endif
+if (inIntMatrixDims(int32(m), 0, 1) != 1)
+  error("bad inIntMatrixDims");
+endif
+if (inFloatMatrixDims(single(m), 1, 0) != 3)
+  error("bad inFloatMatrixDims");
+endif
+
+% Row-major input
+if (inDoubleMatrixRowMajor(m, 1, 2) != 5 || inDoubleMatrixRowMajor(m, 0, 1) != 1)
+  error("bad inDoubleMatrixRowMajor");
+endif
+if (inIntMatrixRowMajor(m, 1, 0) != 3)
+  error("bad inIntMatrixRowMajor");
+endif
+if (inDoubleMatrixRowMajor([1 2 3], 0, 2) != 3)
+  error("bad inDoubleMatrixRowMajor for a vector");
+endif
+
+if (inDoubleMatrixSize([1 2; 3 4]) != 10)
+  error("bad inDoubleMatrixSize");
+endif
+
+% Outputs
+if (!isequal(outDoubleMatrixDims(), m) || !isequal(outDoubleMatrixRowMajor(), m))
+  error("bad outDoubleMatrixDims");
+endif
+r = outIntMatrixRowMajor();
+if (!isa(r, "int32") || !isequal(r, int32(m)))
+  error("bad outIntMatrixRowMajor");
+endif
+r = outFloatMatrixSize();
+if (!isa(r, "single") || !isequal(r, single(0:5)))
+  error("bad outFloatMatrixSize");
+endif
+
+% std::vector
+v = doubleDoubleVector([1 2 3]);
+if (!isequal(v, [2; 4; 6]))
+  error("bad doubleDoubleVector");
+endif
+if (sumIntVector([1 2 3 4]) != 10)
+  error("bad sumIntVector");
+endif
+if (!isequal(doubleDoubleVector([]), zeros(0, 1)))
+  error("bad doubleDoubleVector for an empty vector");
+endif
+
+failed = false;
+try
+  inDoubleMatrixSize("not a matrix");
+catch
+  failed = true;
+end_try_catch
+if (!failed)
+  error("inDoubleMatrixSize accepted a string");
+endif
@@ -0,0 +1,93 @@
+%module octave_li_matrix
+
+%include "matrix.i"
+
+%define %use_matrix_apply(TYPE...)
+%apply (TYPE *IN, int IN_ROWCOUNT, int IN_COLCOUNT) { (TYPE *matrix, int nbRow, int nbCol) }
+%apply (TYPE *IN_ROWMAJOR, int IN_ROWCOUNT, int IN_COLCOUNT) { (TYPE *rowMajor, int nbRow, int nbCol) }
+%apply (TYPE **OUT, int *OUT_ROWCOUNT, int *OUT_COLCOUNT) { (TYPE **matrixRes, int *nbRowRes, int *nbColRes) }
+%apply (TYPE **OUT_ROWMAJOR, int *OUT_ROWCOUNT, int *OUT_COLCOUNT) { (TYPE **rowMajorRes, int *nbRowRes, int *nbColRes) }
+%apply (TYPE *IN, int IN_SIZE) { (TYPE *matrix, int size) }
+%apply (TYPE **OUT, int *OUT_SIZE) { (TYPE **matrixRes, int *sizeRes) }
+%enddef
+
+%use_matrix_apply(int);
+%use_matrix_apply(float);
+%use_matrix_apply(double);
+
+%inline %{
+#include <vector>
+#include <stdlib.h>
+
+template<typename T> T inMatrixSize(T *matrix, int size) {
+  T sum = 0;
+  for (int i = 0; i < size; i++)
+    sum += matrix[i];
+  return sum;
+}
+
+template<typename T> void outMatrixSize(T **matrixRes, int *sizeRes) {
+  *sizeRes = 6;
+  *matrixRes = (T*) malloc(*sizeRes * sizeof(T));
+  for (int i = 0; i < *sizeRes; i++)
+    (*matrixRes)[i] = i;
+}
+
+/* Returns the element at (row, col), reading the matrix as column-major. */
+template<typename T> T inMatrixDims(T *matrix, int nbRow, int nbCol, int row, int col) {
+  return (row < nbRow && col < nbCol) ? matrix[row + col * nbRow] : -1;
+}
+
+/* Returns the element at (row, col), reading the matrix as row-major. */
+template<typename T> T inMatrixRowMajor(T *rowMajor, int nbRow, int nbCol, int row, int col) {
+  return (row < nbRow && col < nbCol) ? rowMajor[row * nbCol + col] : -1;
+}
+
+/* Returns the 2x3 matrix [0 1 2; 3 4 5]. */
+template<typename T> void outMatrixDims(T **matrixRes, int *nbRowRes, int *nbColRes) {
+  *nbRowRes = 2;
+  *nbColRes = 3;
+  *matrixRes = (T*) malloc(6 * sizeof(T));
+  for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 3; j++)
+      (*matrixRes)[i + j * 2] = i * 3 + j;
+}
+
+/* Returns the 2x3 matrix [0 1 2; 3 4 5] built in row-major order. */
+template<typename T> void outMatrixRowMajor(T **rowMajorRes, int *nbRowRes, int *nbColRes) {
+  *nbRowRes = 2;
+  *nbColRes = 3;
+  *rowMajorRes = (T*) malloc(6 * sizeof(T));
+  for (int i = 0; i < 6; i++)
+    (*rowMajorRes)[i] = i;
+}
+
+template<typename T> std::vector<T> doubleVector(const std::vector<T> &v) {
+  std::vector<T> result(v);
+  for (size_t i = 0; i < result.size(); i++)
+    result[i] *= 2;
+  return result;
+}
+
+template<typename T> T sumVector(std::vector<T> v) {
+  T sum = 0;
+  for (size_t i = 0; i < v.size(); i++)
+    sum += v[i];
+  return sum;
+}
+%}
+
+%define %instantiate_matrix_template_functions(NAME, TYPE...)
+%template(in ## NAME ## MatrixSize) inMatrixSize<TYPE>;
+%template(out ## NAME ## MatrixSize) outMatrixSize<TYPE>;
+%template(in ## NAME ## MatrixDims) inMatrixDims<TYPE>;
+%template(in ## NAME ## MatrixRowMajor) inMatrixRowMajor<TYPE>;
+%template(out ## NAME ## MatrixDims) outMatrixDims<TYPE>;
+%template(out ## NAME ## MatrixRowMajor) outMatrixRowMajor<TYPE>;
+%template(double ## NAME ## Vector) doubleVector<TYPE>;
+%template(sum ## NAME ## Vector) sumVector<TYPE>;
+%enddef
+
+%instantiate_matrix_template_functions(Int, int);
+%instantiate_matrix_template_functions(Float, float);
+%instantiate_matrix_template_functions(Double, double);
@@ -0,0 +1,50 @@
+use strict;
+use warnings;
+use Test::More tests => 17;
+BEGIN { use_ok('perl5_fastproxy') }
+use Scalar::Util ();
+require_ok('perl5_fastproxy');
+
+package PerlBase;
+our @ISA = ('perl5_fastproxy::FastBase');
+sub new {
+  my ($pkg, $i) = @_;
+  my $self = perl5_fastproxy::FastBase->new($i);
+  bless $self, $pkg;
+}
+
+package main;
+
+{
+  my $b = perl5_fastproxy::FastBase->new(3);
+  my $d = perl5_fastproxy::FastDerived->new(4);
+  is(Scalar::Util::reftype($b), 'SCALAR', 'proxy is a blessed scalar reference');
+  is($b->getId(), 3, 'method call');
+  is($d->getId(), 4, 'inherited method call');
+  # Repeated conversions hit the cached type check for each stash
+  for my $i (1 .. 3) {
+    is(perl5_fastproxy::baseId($b) + perl5_fastproxy::baseId($d), 7, "conversion $i");
+  }
+  is($d->swig_id_get(), 4, 'member variable getter');
+  $d->swig_id_set(9);
+  is(perl5_fastproxy::baseId($d), 9, 'member variable setter');
+  eval { perl5_fastproxy::baseId(perl5_fastproxy::FastOther->new()) };
+  like($@, qr/TypeError/, 'wrong type rejected');
+  is(perl5_fastproxy::liveObjects(), 2, 'objects alive');
+}
+is(perl5_fastproxy::liveObjects(), 0, 'owned objects destroyed');
+
+{
+  my $h = perl5_fastproxy::Holder->new();
+  my $m = perl5_fastproxy::makeDerived(5);
+  perl5_fastproxy::takeOwnership($h, $m);
+  undef $m;
+  is(perl5_fastproxy::liveObjects(), 1, 'disowned object not destroyed');
+  my $c = $h->clone();
+  undef $c;
+  is(perl5_fastproxy::liveObjects(), 1, 'new object destroyed');
+  my $s = PerlBase->new(6);
+  undef $s;
+  is(perl5_fastproxy::liveObjects(), 1, 'reblessed object destroyed');
+}
+is(perl5_fastproxy::liveObjects(), 0, 'held object destroyed by holder');
@@ -0,0 +1,41 @@
+/* Test the -fastproxy object representation and the proxy type check cache */
+%module perl5_fastproxy
+
+%newobject makeDerived;
+%newobject Holder::clone;
+
+%inline %{
+static int live_objects = 0;
+
+struct FastBase {
+  int id;
+  FastBase(int i = 0) : id(i) { ++live_objects; }
+  virtual ~FastBase() { --live_objects; }
+  int getId() const { return id; }
+};
+
+struct FastDerived : FastBase {
+  FastDerived(int i = 0) : FastBase(i) {}
+};
+
+struct FastOther {
+  int other;
+};
+
+struct Holder {
+  FastBase *held;
+  Holder() : held(0) {}
+  ~Holder() { delete held; }
+  void take(FastBase *b) { delete held; held = b; }
+  FastBase *clone() const { return held ? new FastBase(held->id) : 0; }
+};
+
+int baseId(const FastBase *b) { return b->id; }
+FastBase *makeDerived(int i) { return new FastDerived(i); }
+int liveObjects() { return live_objects; }
+%}
+
+%apply SWIGTYPE *DISOWN { FastBase *disowned };
+%inline %{
+void takeOwnership(Holder *h, FastBase *disowned) { h->take(disowned); }
+%}
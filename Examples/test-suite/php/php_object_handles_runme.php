@@ -0,0 +1,32 @@
+<?php
+
+require "tests.php";
+require "php_object_handles.php";
+
+check::equal(alive(), 0, "No animals yet");
+
+$zoo = new Zoo();
+$a = Zoo::make(false);
+$d = Zoo::make(true);
+check::equal(get_class($a->_cPtr), "SWIG\\Handle", "Pointer not held in a SWIG\\Handle");
+check::equal(alive(), 2, "Two animals");
+check::equal($zoo->listen($a), "...", "Animal passed as proxy");
+check::equal($zoo->listen($d), "woof", "Virtual call through base class pointer");
+check::equal($zoo->listen(null), "silence", "NULL pointer");
+
+// Freeing the proxy runs the C++ destructor.
+$a = null;
+check::equal(alive(), 1, "Owned animal deleted");
+
+// Ownership passes to the Zoo, so dropping the proxy mustn't delete it.
+$zoo->adopt($d);
+$d = null;
+check::equal(alive(), 1, "Disowned animal kept alive");
+check::equal($zoo->kept_animal()->sound(), "woof", "Non-owning proxy");
+check::equal($zoo->kept_animal()->thisown, 0, "thisown for non-owning proxy");
+
+$zoo = null;
+check::equal(alive(), 0, "Zoo deleted its animal");
+
+check::done();
+?>
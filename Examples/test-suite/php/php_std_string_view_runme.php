@@ -0,0 +1,18 @@
+<?php
+
+require "tests.php";
+require "php_std_string_view.php";
+
+check::equal(view_length("hello"), 5, "string_view by value");
+check::equal(view_ref_length("hello"), 5, "string_view by const reference");
+check::equal(view_length("a\0b"), 3, "Embedded NUL not counted as terminator");
+check::equal(view_echo("a\0b"), "a\0b", "Returned string_view copied with its length");
+check::equal(view_literal(), "literal", "Returned string_view of a literal");
+check::equal(view_equals("same", "same"), true, "string_view compares equal");
+check::equal(view_length(123), 3, "Number converted to a string");
+
+check::equal(overloaded("text"), "string_view", "Overload taking string_view");
+check::equal(overloaded(1), "int", "Overload taking int");
+
+check::done();
+?>
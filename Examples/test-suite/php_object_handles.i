@@ -0,0 +1,37 @@
+/* php_object_handles.i - PHP-specific testcase for -objecthandles */
+%module php_object_handles
+
+%newobject Zoo::make;
+%apply SWIGTYPE *DISOWN { Animal *disowned };
+
+%inline %{
+
+static int animals_alive = 0;
+
+class Animal {
+public:
+  Animal() { ++animals_alive; }
+  Animal(const Animal&) { ++animals_alive; }
+  virtual ~Animal() { --animals_alive; }
+  virtual const char *sound() const { return "..."; }
+};
+
+class Dog : public Animal {
+public:
+  virtual const char *sound() const { return "woof"; }
+};
+
+class Zoo {
+  Animal *kept;
+public:
+  Zoo() : kept(0) { }
+  ~Zoo() { delete kept; }
+  static Animal *make(bool dog) { return dog ? new Dog() : new Animal(); }
+  const char *listen(const Animal *a) const { return a ? a->sound() : "silence"; }
+  void adopt(Animal *disowned) { delete kept; kept = disowned; }
+  Animal *kept_animal() const { return kept; }
+};
+
+int alive() { return animals_alive; }
+
+%}
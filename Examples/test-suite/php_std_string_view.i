@@ -0,0 +1,16 @@
+%module php_std_string_view
+
+%include <std_string_view.i>
+
+%inline %{
+#include <string_view>
+
+std::size_t view_length(std::string_view s) { return s.size(); }
+std::size_t view_ref_length(const std::string_view &s) { return s.size(); }
+std::string_view view_echo(std::string_view s) { return s; }
+std::string_view view_literal() { return "literal"; }
+bool view_equals(std::string_view s, const char *t) { return s == t; }
+
+const char *overloaded(std::string_view) { return "string_view"; }
+const char *overloaded(int) { return "int"; }
+%}
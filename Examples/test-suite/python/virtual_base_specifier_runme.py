@@ -0,0 +1,17 @@
+from virtual_base_specifier import *
+
+f = VirtualFirst()
+if f.getB() != 1 or f.getV() != 11:
+    raise RuntimeError("VirtualFirst")
+if not isinstance(f, Base):
+    raise RuntimeError("VirtualFirst is not a Base")
+if VirtualSecond().getV() != 21:
+    raise RuntimeError("VirtualSecond")
+
+v = VirtualAndOther()
+if v.getB() != 1 or v.getO() != 2:
+    raise RuntimeError("VirtualAndOther")
+
+t = VirtualTemplateBase()
+if t.getB() != 1 or t.getT() != 3:
+    raise RuntimeError("VirtualTemplateBase")
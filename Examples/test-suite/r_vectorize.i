@@ -0,0 +1,11 @@
+%module r_vectorize
+
+%rvectorize scale;
+%rvectorize isPositive;
+%feature("rvectorize", "addAll") add;
+
+%inline %{
+double scale(double x, int factor) { return x * factor; }
+bool isPositive(double x) { return x > 0; }
+int add(int a, int b) { return a + b; }
+%}
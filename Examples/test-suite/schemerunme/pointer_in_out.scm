@@ -10,4 +10,8 @@
 
 (check (= (consume-int-pointer q) 11))
 
+(check (equal? q (frobnicate-int-pointer p)))
+(check (not (equal? p q)))
+(check (string-prefix? "#<collectable-swig-pointer int *" (object->string p)))
+
 (exit 0)
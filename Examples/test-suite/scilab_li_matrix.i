@@ -9,6 +9,9 @@
 %apply (TYPE **OUT, int *OUT_SIZE) { (TYPE **matrixRes, int *sizeRes) }
 %enddef
 
+%apply (double *IN_ROWMAJOR, int IN_ROWCOUNT, int IN_COLCOUNT) { (double *rowMajor, int nbRow, int nbCol) }
+%apply (double **OUT_ROWMAJOR, int *OUT_ROWCOUNT, int *OUT_COLCOUNT) { (double **rowMajorRes, int *nbRowRes, int *nbColRes) }
+
 %use_matrix_apply(int);
 %use_matrix_apply(double);
 %use_matrix_apply(char *);
@@ -138,6 +141,23 @@ template<typename T> void inoutMatrixDims(T *matrix, int nbRow, int nbCol,
   inoutMatrixSize(matrix, nbRow * nbCol, matrixRes, &sizeRes);
 }
 
+/*
+ * Row-major (double *matrixIn, int matrixInRowCount, int matrixInColCount) pattern functions
+ */
+
+double inDoubleMatrixRowMajor(double *rowMajor, int nbRow, int nbCol, int row, int col) {
+  return (row < nbRow && col < nbCol) ? rowMajor[row * nbCol + col] : -1;
+}
+
+void outDoubleMatrixRowMajor(double **rowMajorRes, int *nbRowRes, int *nbColRes) {
+  int i;
+  *nbRowRes = 3;
+  *nbColRes = 2;
+  *rowMajorRes = (double*) malloc(6 * sizeof(double));
+  for (i = 0; i < 6; i++)
+    (*rowMajorRes)[i] = i;
+}
+
 %}
 
 %define %instantiate_matrix_template_functions(NAME, TYPE...)
@@ -0,0 +1,45 @@
+
+if [ catch { load ./tcl_pointer_objects[info sharedlibextension] tcl_pointer_objects} err_msg ] {
+	puts stderr "Could not load shared object:\n$err_msg"
+}
+
+proc check {cond msg} {
+  if {![uplevel 1 [list expr $cond]]} {
+    error "Failed: $msg"
+  }
+}
+
+# pointers returned by wrappers convert back without reparsing their string
+set d [new_PtrDerived 3]
+check {[baseId $d] == 3} "derived pointer"
+set p [passThrough $d]
+check {[baseId $p] == 3} "returned pointer"
+check {[string match "_*_p_PtrBase" $p]} "pointer string representation"
+check {[isNull NULL] == 1} "NULL pointer"
+
+# the string form still works, also after being copied
+set s [string range $p 0 end]
+check {[baseId $s] == 3} "pointer string"
+
+# wrong types are rejected
+set o [new_PtrOther]
+check {[catch {baseId $o}] == 1} "wrong type"
+check {[catch {baseId not_a_command}] == 1} "unknown name"
+
+# object names resolve to their instance
+PtrDerived obj1 4
+check {[baseId obj1] == 4} "object name"
+check {[baseId obj1] == 4} "cached object name"
+check {[obj1 getId] == 4} "method call"
+
+# a renamed or recreated object is found again
+rename obj1 obj2
+check {[catch {baseId obj1}] == 1} "renamed object"
+check {[baseId obj2] == 4} "new name"
+obj2 -delete
+PtrDerived obj2 5
+check {[baseId obj2] == 5} "recreated object"
+obj2 -delete
+
+delete_PtrDerived $d
+delete_PtrOther $o
@@ -0,0 +1,23 @@
+/* Test the caching of pointer values and instance commands in Tcl objects */
+%module tcl_pointer_objects
+
+%inline %{
+struct PtrBase {
+  int id;
+  PtrBase(int i = 0) : id(i) {}
+  virtual ~PtrBase() {}
+  int getId() const { return id; }
+};
+
+struct PtrDerived : PtrBase {
+  PtrDerived(int i = 0) : PtrBase(i) {}
+};
+
+struct PtrOther {
+  int other;
+};
+
+int baseId(const PtrBase *b) { return b->id; }
+int isNull(const PtrBase *b) { return b == 0; }
+PtrBase *passThrough(PtrBase *b) { return b; }
+%}
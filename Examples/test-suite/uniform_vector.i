@@ -0,0 +1,60 @@
+%module uniform_vector
+
+%begin %{
+#include <libguile.h>
+/* Also test foreign object pointers where they are available. */
+#if SCM_MAJOR_VERSION > 2 || (SCM_MAJOR_VERSION == 2 && SCM_MINOR_VERSION >= 2)
+#define SWIG_GUILE_FOREIGN_OBJECTS
+#endif
+%}
+
+%include "uniform-vector.i"
+
+%apply std::vector<double> UVECTOR { std::vector<double> };
+%apply const std::vector<double> &UVECTOR { const std::vector<double> & };
+
+%newobject make_point;
+
+%inline %{
+#include <stdlib.h>
+#include <vector>
+
+void scale(double *UVECTOR, size_t UVECTORLEN, double factor) {
+  size_t i;
+  for (i = 0; i < UVECTORLEN; i++)
+    UVECTOR[i] *= factor;
+}
+
+int sum_ints(int UVECTORLEN, const int *UVECTOR) {
+  int i, sum = 0;
+  for (i = 0; i < UVECTORLEN; i++)
+    sum += UVECTOR[i];
+  return sum;
+}
+
+void ramp(size_t *UVECTORLENOUTPUT, float **UVECTOROUTPUT) {
+  size_t i;
+  *UVECTORLENOUTPUT = 4;
+  *UVECTOROUTPUT = (float *)malloc(4 * sizeof(float));
+  for (i = 0; i < 4; i++)
+    (*UVECTOROUTPUT)[i] = (float)i;
+}
+
+std::vector<double> squares(const std::vector<double> &values) {
+  std::vector<double> result;
+  for (size_t i = 0; i < values.size(); i++)
+    result.push_back(values[i] * values[i]);
+  return result;
+}
+
+struct Point {
+  int x, y;
+};
+
+Point *make_point(int x, int y) {
+  Point *p = new Point();
+  p->x = x;
+  p->y = y;
+  return p;
+}
+%}
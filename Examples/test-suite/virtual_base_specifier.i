@@ -0,0 +1,40 @@
+%module(ruby_minherit="1") virtual_base_specifier
+
+%warnfilter(SWIGWARN_JAVA_MULTIPLE_INHERITANCE,
+	    SWIGWARN_CSHARP_MULTIPLE_INHERITANCE,
+	    SWIGWARN_D_MULTIPLE_INHERITANCE,
+	    SWIGWARN_PHP_MULTIPLE_INHERITANCE) VirtualAndOther;	/* C#, D, Java, PHP multiple inheritance */
+
+// The virtual keyword is accepted before and after the access specifier of a
+// base class and the virtual base classes are recorded for the language modules.
+%inline %{
+struct Base {
+  Base() : b(1) {}
+  virtual ~Base() {}
+  int b;
+  int getB() const { return b; }
+};
+
+struct Other {
+  Other() : o(2) {}
+  int o;
+  int getO() const { return o; }
+};
+
+struct VirtualFirst : virtual public Base {
+  int getV() const { return b + 10; }
+};
+
+struct VirtualSecond : public virtual Base {
+  int getV() const { return b + 20; }
+};
+
+struct VirtualAndOther : virtual Base, Other {
+};
+
+template<class T> struct VirtualTemplate : virtual T {
+  int getT() const { return 3; }
+};
+%}
+
+%template(VirtualTemplateBase) VirtualTemplate<Base>;
@@ -0,0 +1,37 @@
+/* The members of a base class which is not the embind base are wrapped like
+   those of the class itself, through thunks which reach the base. */
+
+%module wasm_base_members
+
+%wasmcopy ns::Second::copied;
+
+%inline %{
+namespace ns {
+  struct Item { int x; };
+  typedef int count_t;
+
+  struct First { int f; };
+
+  struct Second {
+    struct Nested { int y; };
+    typedef Nested nested_t;
+
+    Item item;
+    Item copied;
+    Item *item_ptr;
+    int *int_ptr;
+    const int fixed;
+    count_t count;
+    int values[4];
+
+    Second() : item_ptr(0), int_ptr(0), fixed(1), count(0) {}
+    Nested nested(nested_t n, count_t c) const { return n; }
+    Item make(int x) { Item i = { x }; return i; }
+    int over(int a) { return a; }
+    int over(double a) { return (int)a; }
+    int over(int a, int b) { return a + b; }
+  };
+}
+
+struct Derived : ns::First, ns::Second { int d; };
+%}
@@ -0,0 +1,9 @@
+/* -wasm-finalize tracks every class except those with %nowasmfinalize. */
+%module wasm_finalize_all
+
+%nowasmfinalize Untracked;
+
+%inline %{
+struct Tracked { int x; };
+struct Untracked { int y; };
+%}
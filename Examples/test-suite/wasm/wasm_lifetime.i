@@ -0,0 +1,12 @@
+/* %wasmfinalize tracks objects constructed from JS with a FinalizationRegistry,
+   and %wasmpool constructs them from a pool through std::allocate_shared. */
+%module wasm_lifetime
+
+%wasmfinalize Tracked;
+%wasmpool Pooled;
+
+%inline %{
+struct Tracked { int x; };
+struct Pooled { Pooled() {} Pooled(int v) : v(v) {} int v; };
+struct Plain { int y; };
+%}
@@ -0,0 +1,9 @@
+/* std::map lookups do not insert, and maps of arithmetic keys and values
+   are read in batches through typed arrays. */
+%module wasm_map
+
+%include <std_string.i>
+%include <std_map.i>
+
+%template(IntDoubleMap) std::map<int, double>;
+%template(StringIntMap) std::map<std::string, int>;
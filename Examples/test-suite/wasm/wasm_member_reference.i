@@ -0,0 +1,26 @@
+/* Member variables which are objects of a wrapped class, or pointers to one,
+   are read as std::shared_ptr handles referring to the member.  Only the
+   classes read this way, and pooled classes, register the smart pointer. */
+
+%module wasm_member_reference
+
+%wasmcopy Outer::copied;
+%wasmpool Pooled;
+
+%inline %{
+struct Inner { int x; };
+struct Unused { int y; };
+struct Pooled { int z; };
+
+struct Outer {
+  Inner inner;
+  Inner *inner_ptr;
+  Unused copied;
+  int plain;
+  Outer() : inner_ptr(0) {}
+};
+
+struct Holder {
+  Outer outer;
+};
+%}
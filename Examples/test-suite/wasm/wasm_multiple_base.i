@@ -0,0 +1,13 @@
+/* The first base class is given to embind as base<>, the members of the
+   other base classes are added to the class. */
+
+%module wasm_multiple_base
+
+%inline %{
+struct A { int a; int fa() { return a; } };
+struct B { int b; int fb() { return b; } };
+struct C { int c; int fc() { return c; } };
+
+struct Single : A { int s; };
+struct Multiple : A, B, C { int m; };
+%}
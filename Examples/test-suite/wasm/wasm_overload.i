@@ -0,0 +1,23 @@
+/* Overloads are dispatched in JS, with a switch on the number of arguments
+   and type checks on the arguments which tell the overloads apart. */
+
+%module wasm_overload
+
+%inline %{
+struct Base { virtual ~Base() {} };
+struct Derived : Base {};
+struct Other {};
+
+int f() { return 0; }
+int f(int i) { return 1; }
+int f(double d) { return 2; }
+int f(const char *s) { return 3; }
+int f(int i, int j) { return 4; }
+
+int g(char c) { return 1; }
+int g(bool b) { return 2; }
+
+int h(Base &b) { return 1; }
+int h(Derived &d) { return 2; }
+int h(Other &o) { return 3; }
+%}
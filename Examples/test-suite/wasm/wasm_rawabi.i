@@ -0,0 +1,38 @@
+/* With -wasm-rawabi, objects are only passed to the exports as the address
+   held by their handle if it is a live handle of exactly the class of the
+   parameter.  A handle of Derived, whose A subobject follows the vtable
+   pointer, is passed through the function registered with embind instead.
+   Functions with code wrapped around the call are not exported. */
+
+%module wasm_rawabi
+
+%include <std_string.i>
+
+%exception guarded {
+  $action
+}
+%catches(int) caught;
+%contract checked(int x) {
+require:
+  x > 0;
+}
+%typemap(in) int mapped_arg "$1 = (int)$input * 2;"
+
+%inline %{
+struct A {
+  int a;
+  int fa() { return a; }
+  static int twice(const A &x) { return 2 * x.a; }
+};
+struct Derived : A { virtual ~Derived() {} };
+
+int geta(A *p) { return p ? p->a : -1; }
+int sum(A *p, const A &q) { return (p ? p->a : 0) + q.a; }
+int add(int x, int y) { return x + y; }
+
+int guarded(int x) { return x; }
+int caught(int x) { return x; }
+int checked(int x) { return x; }
+int mapped(int mapped_arg) { return mapped_arg; }
+int length(const char *s) { return s ? (int)strlen(s) : 0; }
+%}
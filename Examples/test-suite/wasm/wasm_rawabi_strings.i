@@ -0,0 +1,16 @@
+/* With -wasm-rawabi and std_string.i, strings are passed to and returned from
+   the exports as UTF-8 in the wasm heap. */
+
+%module wasm_rawabi_strings
+
+%include <std_string.i>
+
+%inline %{
+#include <string>
+#include <string_view>
+
+std::string upper(const std::string &s) { return s; }
+const std::string &name() { static std::string n("name"); return n; }
+std::string_view view(std::string_view s) { return s; }
+const char *cstr(const char *s) { return s; }
+%}
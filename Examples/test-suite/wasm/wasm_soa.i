@@ -0,0 +1,20 @@
+/* %wasmsoa views arrays of structs as arrays of their arithmetic fields. */
+
+%module wasm_soa
+
+%include <std_vector.i>
+
+%wasmsoa Particle;
+
+%inline %{
+struct Particle {
+  float x;
+  double mass;
+  int id;
+  unsigned flags : 3;
+  unsigned char kind;
+  Particle *next;
+};
+%}
+
+%template(ParticleVector) std::vector<Particle>;
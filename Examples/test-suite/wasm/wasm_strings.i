@@ -0,0 +1,12 @@
+/* Without -wasm-rawabi, std_string.i adds nothing and strings are converted
+   by embind. */
+
+%module wasm_strings
+
+%include <std_string.i>
+
+%inline %{
+#include <string>
+
+std::string echo(const std::string &s) { return s; }
+%}
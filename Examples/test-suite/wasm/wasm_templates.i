@@ -0,0 +1,20 @@
+/* Code fragments whose placeholders share a prefix, such as
+   $wasm_classname, $wasm_classname_view and $wasm_classnameSoA, render each
+   placeholder and leave none in the generated code. */
+%module wasm_templates
+
+%include <std_vector.i>
+%include <std_map.i>
+
+%wasmsoa Sample;
+
+%inline %{
+struct Sample { float value; int index; };
+struct Left { int l; };
+struct Right { int r; };
+struct Both : Left, Right { int b; };
+%}
+
+%template(SampleVector) std::vector<Sample>;
+%template(FloatVector) std::vector<float>;
+%template(IntFloatMap) std::map<int, float>;
@@ -0,0 +1,15 @@
+/* std::vector of an arithmetic type gets view(), assign() and copyTo(), which
+   access the elements through a typed array without a call per element. */
+
+%module wasm_vector
+
+%include <std_vector.i>
+
+%template(DoubleVector) std::vector<double>;
+%template(IntVector) std::vector<int>;
+%template(UCharVector) std::vector<unsigned char>;
+
+%inline %{
+struct Point { int x; };
+%}
+%template(PointVector) std::vector<Point>;
@@ -0,0 +1,18 @@
+/* embind casts a base class pointer down to the class with a static_cast,
+   so a virtual first base must not be given to embind as base<>.  Its
+   members are added to the class like those of other secondary bases. */
+
+%module wasm_virtual_base
+
+%inline %{
+struct A { int a; int fa() { return a; } };
+struct B { int b; int fb() { return b; } };
+
+struct NonVirtual : A, B { int n; };
+struct VirtualFirst : virtual A { int v; };
+struct VirtualFirstOfTwo : public virtual A, B { int w; };
+
+template<class T> struct VirtualTemplate : virtual T { int t; };
+%}
+
+%template(VirtualTemplateA) VirtualTemplate<A>;
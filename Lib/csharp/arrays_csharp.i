@@ -49,6 +49,23 @@
  *   %csmethodmodifiers myArrayCopy "public unsafe";
  *   void myArrayCopy( int *sourceArray, int* targetArray, int nitems );
  *
+ * Span approach
+ * -------------
+ * The SPAN[] and READONLYSPAN[] typemaps also use pinning, but take a
+ * System.Span<T> or System.ReadOnlySpan<T> instead of a managed array, so
+ * slices of arrays, stackalloc buffers and native memory can be passed
+ * without copying. The same restrictions as for the pinning approach apply.
+ * Use CSHARP_SPAN to add these typemaps for other blittable types, such as
+ * structs wrapped with %csblittable.
+ *
+ * Example usage:
+ *
+ *   %include "arrays_csharp.i"
+ *   %apply double READONLYSPAN[] { const double *sourceArray }
+ *   %apply double SPAN[] { double *targetArray }
+ *   %csmethodmodifiers myArrayCopy "public unsafe";
+ *   void myArrayCopy( const double *sourceArray, double *targetArray, int nitems );
+ *
  * ----------------------------------------------------------------------------- */
 
 %define CSHARP_ARRAYS( CTYPE, CSTYPE )
@@ -177,3 +194,42 @@ CSHARP_ARRAYS_FIXED(float, float)
 CSHARP_ARRAYS_FIXED(double, double)
 CSHARP_ARRAYS_FIXED(bool, bool)
 
+
+%define CSHARP_SPAN( CTYPE, CSTYPE )
+
+%typemap(ctype)   CTYPE SPAN[] "CTYPE*"
+%typemap(imtype)  CTYPE SPAN[] "global::System.IntPtr"
+%typemap(cstype)  CTYPE SPAN[] "global::System.Span<CSTYPE>"
+%typemap(csin,
+           pre=       "    fixed ( CSTYPE* swig_ptrTo_$csinput = $csinput ) {",
+           terminator="    }") 
+                  CTYPE SPAN[] "(global::System.IntPtr)swig_ptrTo_$csinput"
+
+%typemap(in)      CTYPE SPAN[] "$1 = $input;"
+%typemap(freearg) CTYPE SPAN[] ""
+%typemap(argout)  CTYPE SPAN[] ""
+
+%typemap(ctype)   CTYPE READONLYSPAN[] "CTYPE*"
+%typemap(imtype)  CTYPE READONLYSPAN[] "global::System.IntPtr"
+%typemap(cstype)  CTYPE READONLYSPAN[] "global::System.ReadOnlySpan<CSTYPE>"
+%typemap(csin,
+           pre=       "    fixed ( CSTYPE* swig_ptrTo_$csinput = $csinput ) {",
+           terminator="    }") 
+                  CTYPE READONLYSPAN[] "(global::System.IntPtr)swig_ptrTo_$csinput"
+
+%typemap(in)      CTYPE READONLYSPAN[] "$1 = $input;"
+%typemap(freearg) CTYPE READONLYSPAN[] ""
+%typemap(argout)  CTYPE READONLYSPAN[] ""
+
+%enddef // CSHARP_SPAN
+
+CSHARP_SPAN(signed char, sbyte)
+CSHARP_SPAN(unsigned char, byte)
+CSHARP_SPAN(short, short)
+CSHARP_SPAN(unsigned short, ushort)
+CSHARP_SPAN(int, int)
+CSHARP_SPAN(unsigned int, uint)
+CSHARP_SPAN(long long, long)
+CSHARP_SPAN(unsigned long long, ulong)
+CSHARP_SPAN(float, float)
+CSHARP_SPAN(double, double)
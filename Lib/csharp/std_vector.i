@@ -13,6 +13,14 @@
  *
  *   SWIG_STD_VECTOR_ENHANCED(SomeNamespace::Klass)
  *   %template(VectKlass) std::vector<SomeNamespace::Klass>;
+ *
+ * For vectors of structs wrapped with %csblittable, use the SWIG_STD_VECTOR_BLITTABLE macro
+ * to add AsSpan() and CopyFrom() for accessing the elements in place without copying each
+ * element across the managed-native boundary. The proxy class must be compiled with -unsafe.
+ *
+ *   %csblittable(Point)
+ *   SWIG_STD_VECTOR_BLITTABLE(Point)
+ *   %template(VectPoint) std::vector<Point>;
  * ----------------------------------------------------------------------------- */
 
 %include <std_common.i>
@@ -347,6 +355,33 @@
     }
 %enddef
 
+// Extra methods added to the collection class if the elements have the same layout in C# and C++
+// AsSpan() returns a view onto the vector's storage which is only valid until the vector is resized or destroyed
+%define SWIG_STD_VECTOR_EXTRA_SPAN(CTYPE...)
+    %extend {
+      %apply void *VOID_INT_PTR { void *swigdata, void *swigvalues }
+      void *swigdata() {
+        return $self->empty() ? 0 : (void *)&(*$self)[0];
+      }
+      void swigassign(void *swigvalues, int count) {
+        const CTYPE *first = (const CTYPE *)swigvalues;
+        $self->assign(first, first + count);
+      }
+    }
+    %proxycode %{
+  public unsafe global::System.Span<$typemap(cstype, CTYPE)> AsSpan() {
+    return new global::System.Span<$typemap(cstype, CTYPE)>((void *)swigdata(), Count);
+  }
+
+  // Replaces the contents of the vector with a single copy
+  public unsafe void CopyFrom(global::System.ReadOnlySpan<$typemap(cstype, CTYPE)> values) {
+    fixed ($typemap(cstype, CTYPE)* valuesPtr = values) {
+      swigassign((global::System.IntPtr)valuesPtr, values.Length);
+    }
+  }
+%}
+%enddef
+
 // Macros for std::vector class specializations/enhancements
 %define SWIG_STD_VECTOR_ENHANCED(CTYPE...)
 namespace std {
@@ -357,6 +392,15 @@ namespace std {
 }
 %enddef
 
+%define SWIG_STD_VECTOR_BLITTABLE(CTYPE...)
+namespace std {
+  template<> class vector< CTYPE > {
+    SWIG_STD_VECTOR_MINIMUM_INTERNAL(IEnumerable, const value_type&, %arg(CTYPE))
+    SWIG_STD_VECTOR_EXTRA_SPAN(CTYPE)
+  };
+}
+%enddef
+
 // Legacy macros
 %define SWIG_STD_VECTOR_SPECIALIZE(CSTYPE, CTYPE...)
 #warning SWIG_STD_VECTOR_SPECIALIZE macro deprecated, please see csharp/std_vector.i and switch to SWIG_STD_VECTOR_ENHANCED
@@ -379,6 +423,8 @@ SWIG_STD_VECTOR_ENHANCED(CTYPE)
 %csmethodmodifiers std::vector::size "private"
 %csmethodmodifiers std::vector::capacity "private"
 %csmethodmodifiers std::vector::reserve "private"
+%csmethodmodifiers std::vector::swigdata "private"
+%csmethodmodifiers std::vector::swigassign "private"
 
 namespace std {
   // primary (unspecialized) class template for std::vector
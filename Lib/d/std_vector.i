@@ -603,3 +603,56 @@ SWIG_STD_VECTOR_ENHANCED(unsigned long long)
 SWIG_STD_VECTOR_ENHANCED(float)
 SWIG_STD_VECTOR_ENHANCED(double)
 SWIG_STD_VECTOR_ENHANCED(std::string) // also requires a %include <std_string.i>
+
+
+/*
+ * std::vector<T> & SLICE typemaps for the primitive types, mapping a vector
+ * to a D slice. A returned reference becomes a slice referring to the vector's
+ * storage, without copying; the vector must not be resized or destroyed
+ * while the slice is used. An input slice is copied into a temporary vector
+ * on the C++ side, so the GC heap is not used in either direction. Apply them
+ * using, for example:
+ *   %apply const std::vector<float> &SLICE { const std::vector<float> & }
+ */
+#if (SWIG_D_VERSION > 1)
+%define SWIG_STD_VECTOR_SLICE(CTYPE, DTYPE)
+%typemap(ctype, fragment="SWIG_DSlice") const std::vector< CTYPE > &SLICE, std::vector< CTYPE > &SLICE "SWIG_DSlice"
+%typemap(imtype) const std::vector< CTYPE > &SLICE, std::vector< CTYPE > &SLICE "SwigDSlice"
+%typemap(dtype) const std::vector< CTYPE > &SLICE "const(DTYPE)[]"
+%typemap(dtype) std::vector< CTYPE > &SLICE "DTYPE[]"
+
+%typemap(in) const std::vector< CTYPE > &SLICE ($*1_ltype temp)
+%{ temp.assign((const CTYPE *)$input.ptr, (const CTYPE *)$input.ptr + $input.length);
+   $1 = &temp; %}
+%typemap(din) const std::vector< CTYPE > &SLICE
+  "$imdmodule.SwigDSlice($dinput.length, cast(void*)$dinput.ptr)"
+
+%typemap(out) const std::vector< CTYPE > &SLICE, std::vector< CTYPE > &SLICE
+%{ $result.length = $1->size();
+   $result.ptr = $1->empty() ? 0 : (void *)&(*$1)[0]; %}
+%typemap(dout, excode=SWIGEXCODE) const std::vector< CTYPE > &SLICE {
+  auto ret = $imcall;$excode
+  return (cast(const(DTYPE)*)ret.ptr)[0 .. ret.length];
+}
+%typemap(dout, excode=SWIGEXCODE) std::vector< CTYPE > &SLICE {
+  auto ret = $imcall;$excode
+  return (cast(DTYPE*)ret.ptr)[0 .. ret.length];
+}
+%enddef
+
+SWIG_STD_VECTOR_SLICE(char, char)
+SWIG_STD_VECTOR_SLICE(signed char, byte)
+SWIG_STD_VECTOR_SLICE(unsigned char, ubyte)
+SWIG_STD_VECTOR_SLICE(short, short)
+SWIG_STD_VECTOR_SLICE(unsigned short, ushort)
+SWIG_STD_VECTOR_SLICE(int, int)
+SWIG_STD_VECTOR_SLICE(unsigned int, uint)
+SWIG_STD_VECTOR_SLICE(long, SWIG_LONG_DTYPE)
+SWIG_STD_VECTOR_SLICE(unsigned long, SWIG_ULONG_DTYPE)
+SWIG_STD_VECTOR_SLICE(long long, long)
+SWIG_STD_VECTOR_SLICE(unsigned long long, ulong)
+SWIG_STD_VECTOR_SLICE(float, float)
+SWIG_STD_VECTOR_SLICE(double, double)
+
+#undef SWIG_STD_VECTOR_SLICE
+#endif
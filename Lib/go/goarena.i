@@ -0,0 +1,178 @@
+/* -----------------------------------------------------------------------------
+ * goarena.i
+ *
+ * Monotonic memory arenas owned by Go.  Constructors with the go:arena
+ * feature (see %goarena) get an extra New<Class>InArena function which
+ * allocates the object in a SwigArena.  Objects in an arena must not be
+ * deleted individually; their destructors are run and their memory released
+ * when the arena is reset or deleted, each in a single call.
+ * ----------------------------------------------------------------------------- */
+
+%{
+#include <stdlib.h>
+#include <string.h>
+#ifdef __cplusplus
+#include <new>
+#endif
+
+/* The size of the blocks that small objects are allocated from. */
+#ifndef SWIG_GOARENA_BLOCK_SIZE
+#define SWIG_GOARENA_BLOCK_SIZE 65536
+#endif
+
+/* All allocations are aligned for any fundamental type. */
+#define SWIG_GOARENA_ALIGN 16
+#define SWIG_GOARENA_ROUND(size) (((size) + SWIG_GOARENA_ALIGN - 1) & ~(size_t)(SWIG_GOARENA_ALIGN - 1))
+
+typedef struct swig_go_arena_block {
+  struct swig_go_arena_block *next;
+  size_t size;
+  size_t used;
+} swig_go_arena_block;
+
+/* A destructor to run when the arena is reset, stored just before the object. */
+typedef struct swig_go_arena_cleanup {
+  struct swig_go_arena_cleanup *next;
+  void (*destroy)(void *);
+  void *object;
+} swig_go_arena_cleanup;
+
+typedef struct SwigGoArena {
+  /* The block currently allocated from comes first. */
+  swig_go_arena_block *blocks;
+  /* The most recently constructed object comes first. */
+  swig_go_arena_cleanup *cleanups;
+  size_t allocated;
+} SwigGoArena;
+
+SWIGINTERN void *SWIG_GoArena_Allocate(SwigGoArena *arena, size_t size) {
+  swig_go_arena_block *block = arena->blocks;
+  size = SWIG_GOARENA_ROUND(size);
+  if (!block || block->size - block->used < size) {
+    size_t block_size = size > SWIG_GOARENA_BLOCK_SIZE ? size : SWIG_GOARENA_BLOCK_SIZE;
+    block = (swig_go_arena_block *)malloc(SWIG_GOARENA_ROUND(sizeof(swig_go_arena_block)) + block_size);
+    if (!block) {
+#ifdef __cplusplus
+      throw std::bad_alloc();
+#else
+      return 0;
+#endif
+    }
+    block->size = block_size;
+    block->used = 0;
+    if (arena->blocks && size > SWIG_GOARENA_BLOCK_SIZE / 4) {
+      /* A large object gets a block of its own, behind the current one
+         so that the rest of the current block is not wasted. */
+      block->next = arena->blocks->next;
+      arena->blocks->next = block;
+    } else {
+      block->next = arena->blocks;
+      arena->blocks = block;
+    }
+  }
+  block->used += size;
+  arena->allocated += size;
+  return (char *)block + SWIG_GOARENA_ROUND(sizeof(swig_go_arena_block)) + block->used - size;
+}
+
+/* Allocate memory for an object together with the record used to destroy it. */
+SWIGINTERN void *SWIG_GoArena_AllocateObject(SwigGoArena *arena, size_t size, swig_go_arena_cleanup **cleanup) {
+  char *p = (char *)SWIG_GoArena_Allocate(arena, SWIG_GOARENA_ROUND(sizeof(swig_go_arena_cleanup)) + size);
+  *cleanup = (swig_go_arena_cleanup *)p;
+  return p ? p + SWIG_GOARENA_ROUND(sizeof(swig_go_arena_cleanup)) : 0;
+}
+
+/* Called once the object has been constructed, so never fails. */
+SWIGINTERN void SWIG_GoArena_AddCleanup(SwigGoArena *arena, swig_go_arena_cleanup *cleanup, void *object, void (*destroy)(void *)) {
+  cleanup->next = arena->cleanups;
+  cleanup->destroy = destroy;
+  cleanup->object = object;
+  arena->cleanups = cleanup;
+}
+
+#ifdef __cplusplus
+template <typename T> SWIGINTERN void SWIG_GoArena_Destroy(void *object) {
+  static_cast<T *>(object)->~T();
+}
+#endif
+
+/* Destroy the objects in reverse order of construction and release all but
+   one block, which is kept for reuse. */
+SWIGINTERN void SWIG_GoArena_Reset(SwigGoArena *arena) {
+  swig_go_arena_cleanup *cleanup = arena->cleanups;
+  swig_go_arena_block *block = arena->blocks;
+  swig_go_arena_block *keep = 0;
+  arena->cleanups = 0;
+  while (cleanup) {
+    swig_go_arena_cleanup *next = cleanup->next;
+    cleanup->destroy(cleanup->object);
+    cleanup = next;
+  }
+  while (block) {
+    swig_go_arena_block *next = block->next;
+    if (!keep && block->size == SWIG_GOARENA_BLOCK_SIZE) {
+      keep = block;
+      keep->next = 0;
+      keep->used = 0;
+    } else {
+      free(block);
+    }
+    block = next;
+  }
+  arena->blocks = keep;
+  arena->allocated = 0;
+}
+
+SWIGINTERN SwigGoArena *SWIG_GoArena_New(void) {
+  SwigGoArena *arena = (SwigGoArena *)malloc(sizeof(SwigGoArena));
+  if (arena) {
+    arena->blocks = 0;
+    arena->cleanups = 0;
+    arena->allocated = 0;
+  }
+  return arena;
+}
+
+SWIGINTERN void SWIG_GoArena_Delete(SwigGoArena *arena) {
+  SWIG_GoArena_Reset(arena);
+  free(arena->blocks);
+  free(arena);
+}
+%}
+
+#define %goarena %feature("go:arena")
+#define %nogoarena %feature("go:arena","0")
+
+/* The arena parameter of a New<Class>InArena function. */
+%typemap(check) SwigGoArena *swig_arena %{
+  if (!$1) {
+    _swig_gopanic("nil SwigArena");
+  }
+%}
+
+%rename(SwigArena) SwigGoArena;
+%nogoarena SwigGoArena;
+
+%nodefaultctor SwigGoArena;
+%nodefaultdtor SwigGoArena;
+struct SwigGoArena {
+  %extend {
+    SwigGoArena() {
+      return SWIG_GoArena_New();
+    }
+
+    ~SwigGoArena() {
+      SWIG_GoArena_Delete($self);
+    }
+
+    /* Destroy all the objects in the arena, keeping it for reuse. */
+    void Reset() {
+      SWIG_GoArena_Reset($self);
+    }
+
+    /* The number of bytes allocated since the arena was created or reset. */
+    long long Allocated() {
+      return (long long)$self->allocated;
+    }
+  }
+};
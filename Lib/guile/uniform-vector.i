@@ -0,0 +1,236 @@
+/* -----------------------------------------------------------------------------
+ * uniform-vector.i
+ *
+ * Guile typemaps for passing arrays as SRFI-4 uniform numeric vectors
+ * ----------------------------------------------------------------------------- */
+
+/* Unlike the typemaps in list-vector.i, which convert arrays element by
+   element, these typemaps share the storage of a uniform vector (such as an
+   f64vector) with C, or hand over a C array to a new uniform vector.
+
+   TYPEMAP_UNIFORM_VECTOR(C_TYPE, TAG, ELEM_TYPE, PRECEDENCE)
+
+   TAG names the uniform vector type, eg f64 for f64vector, and ELEM_TYPE
+   the C type Guile uses for its elements, eg double.  C_TYPE must have the
+   same representation as ELEM_TYPE.
+
+   Supported calling conventions:
+
+   func(int UVECTORLEN, [const] C_TYPE *UVECTOR)
+   func([const] C_TYPE *UVECTOR, int UVECTORLEN)
+
+       Scheme wrapper will take one argument, a uniform vector of the
+       matching type.  The C function is passed the address of the vector
+       storage and its length; nothing is copied, so changes made by the C
+       function are visible in Scheme.  The storage must not be used after
+       the C function has returned.  The non-const variants do not accept
+       read-only vectors, such as literals in compiled code.
+
+   func(int *UVECTORLENOUTPUT, C_TYPE **UVECTOROUTPUT)
+
+       Scheme wrapper will take no arguments.  The C function is expected
+       to return address and length of an array allocated with malloc()
+       through these pointers.  The array becomes the storage of the
+       uniform vector returned, which frees it when it is garbage
+       collected.
+
+   std::vector<C_TYPE> UVECTOR
+   const std::vector<C_TYPE> &UVECTOR
+
+       In C++, input std::vectors are filled from a uniform vector and
+       std::vectors returned by value are converted to a uniform vector,
+       with a single block copy in either direction.  To convert all
+       std::vector<double> results, for example, use
+
+	 %apply std::vector<double> UVECTOR { std::vector<double> };
+
+       after any %template for std::vector<double>.
+
+   It is also allowed to use "size_t" lengths rather than "int".  */
+
+%define TYPEMAP_UNIFORM_VECTOR(C_TYPE, TAG, ELEM_TYPE, PRECEDENCE)
+
+     %typecheck(PRECEDENCE)
+       (int UVECTORLEN, C_TYPE *UVECTOR), (size_t UVECTORLEN, C_TYPE *UVECTOR),
+       (int UVECTORLEN, const C_TYPE *UVECTOR), (size_t UVECTORLEN, const C_TYPE *UVECTOR),
+       (C_TYPE *UVECTOR, int UVECTORLEN), (C_TYPE *UVECTOR, size_t UVECTORLEN),
+       (const C_TYPE *UVECTOR, int UVECTORLEN), (const C_TYPE *UVECTOR, size_t UVECTORLEN)
+     {
+       $1 = scm_is_##TAG##vector($input) ? 1 : 0;
+     }
+
+     /* input */
+
+     %typemap(in, doc="$NAME is a " #TAG "vector")
+       (int UVECTORLEN, C_TYPE *UVECTOR) (scm_t_array_handle handle, size_t len, ssize_t inc),
+       (size_t UVECTORLEN, C_TYPE *UVECTOR) (scm_t_array_handle handle, size_t len, ssize_t inc)
+     {
+       if (!scm_is_##TAG##vector($input))
+	 scm_wrong_type_arg(FUNC_NAME, $argnum, $input);
+       $2 = ($2_ltype) scm_##TAG##vector_writable_elements($input, &handle, &len, &inc);
+       if (inc != 1) {
+	 scm_array_handle_release(&handle);
+	 scm_wrong_type_arg(FUNC_NAME, $argnum, $input);
+       }
+       $1 = ($1_ltype) len;
+     }
+
+     %typemap(in, doc="$NAME is a " #TAG "vector")
+       (int UVECTORLEN, const C_TYPE *UVECTOR) (scm_t_array_handle handle, size_t len, ssize_t inc),
+       (size_t UVECTORLEN, const C_TYPE *UVECTOR) (scm_t_array_handle handle, size_t len, ssize_t inc)
+     {
+       if (!scm_is_##TAG##vector($input))
+	 scm_wrong_type_arg(FUNC_NAME, $argnum, $input);
+       $2 = ($2_ltype) scm_##TAG##vector_elements($input, &handle, &len, &inc);
+       if (inc != 1) {
+	 scm_array_handle_release(&handle);
+	 scm_wrong_type_arg(FUNC_NAME, $argnum, $input);
+       }
+       $1 = ($1_ltype) len;
+     }
+
+     %typemap(in, doc="$NAME is a " #TAG "vector")
+       (C_TYPE *UVECTOR, int UVECTORLEN) (scm_t_array_handle handle, size_t len, ssize_t inc),
+       (C_TYPE *UVECTOR, size_t UVECTORLEN) (scm_t_array_handle handle, size_t len, ssize_t inc)
+     {
+       if (!scm_is_##TAG##vector($input))
+	 scm_wrong_type_arg(FUNC_NAME, $argnum, $input);
+       $1 = ($1_ltype) scm_##TAG##vector_writable_elements($input, &handle, &len, &inc);
+       if (inc != 1) {
+	 scm_array_handle_release(&handle);
+	 scm_wrong_type_arg(FUNC_NAME, $argnum, $input);
+       }
+       $2 = ($2_ltype) len;
+     }
+
+     %typemap(in, doc="$NAME is a " #TAG "vector")
+       (const C_TYPE *UVECTOR, int UVECTORLEN) (scm_t_array_handle handle, size_t len, ssize_t inc),
+       (const C_TYPE *UVECTOR, size_t UVECTORLEN) (scm_t_array_handle handle, size_t len, ssize_t inc)
+     {
+       if (!scm_is_##TAG##vector($input))
+	 scm_wrong_type_arg(FUNC_NAME, $argnum, $input);
+       $1 = ($1_ltype) scm_##TAG##vector_elements($input, &handle, &len, &inc);
+       if (inc != 1) {
+	 scm_array_handle_release(&handle);
+	 scm_wrong_type_arg(FUNC_NAME, $argnum, $input);
+       }
+       $2 = ($2_ltype) len;
+     }
+
+     /* Do not check for NULL pointers (override checks). */
+
+     %typemap(check)
+       (int UVECTORLEN, C_TYPE *UVECTOR), (size_t UVECTORLEN, C_TYPE *UVECTOR),
+       (int UVECTORLEN, const C_TYPE *UVECTOR), (size_t UVECTORLEN, const C_TYPE *UVECTOR),
+       (C_TYPE *UVECTOR, int UVECTORLEN), (C_TYPE *UVECTOR, size_t UVECTORLEN),
+       (const C_TYPE *UVECTOR, int UVECTORLEN), (const C_TYPE *UVECTOR, size_t UVECTORLEN)
+       "/* no check for NULL pointer */";
+
+     %typemap(freearg)
+       (int UVECTORLEN, C_TYPE *UVECTOR), (size_t UVECTORLEN, C_TYPE *UVECTOR),
+       (int UVECTORLEN, const C_TYPE *UVECTOR), (size_t UVECTORLEN, const C_TYPE *UVECTOR),
+       (C_TYPE *UVECTOR, int UVECTORLEN), (C_TYPE *UVECTOR, size_t UVECTORLEN),
+       (const C_TYPE *UVECTOR, int UVECTORLEN), (const C_TYPE *UVECTOR, size_t UVECTORLEN)
+       "scm_array_handle_release(&handle$argnum);";
+
+     /* output */
+
+     %typemap(in,numinputs=0) (int *UVECTORLENOUTPUT, C_TYPE **UVECTOROUTPUT)
+                                (int arraylentemp, C_TYPE *arraytemp),
+                              (size_t *UVECTORLENOUTPUT, C_TYPE **UVECTOROUTPUT)
+                                (size_t arraylentemp, C_TYPE *arraytemp)
+     %{
+       arraytemp = NULL;
+       $1 = &arraylentemp;
+       $2 = &arraytemp;
+     %}
+
+     /* The uniform vector takes over the array, so there is no freearg
+        typemap. */
+
+     %typemap(argout, doc="$NAME (a " #TAG "vector)")
+          (int *UVECTORLENOUTPUT, C_TYPE **UVECTOROUTPUT),
+          (size_t *UVECTORLENOUTPUT, C_TYPE **UVECTOROUTPUT)
+     {
+       SWIG_APPEND_VALUE(scm_take_##TAG##vector((ELEM_TYPE *) *$2, (size_t) *$1));
+     }
+
+#ifdef __cplusplus
+
+     %typecheck(PRECEDENCE) std::vector< C_TYPE > UVECTOR, const std::vector< C_TYPE > &UVECTOR {
+       $1 = scm_is_##TAG##vector($input) ? 1 : 0;
+     }
+
+     %typemap(in, doc="$NAME is a " #TAG "vector") std::vector< C_TYPE > UVECTOR {
+       scm_t_array_handle handle;
+       size_t len, i;
+       ssize_t inc;
+       const C_TYPE *elements;
+       if (!scm_is_##TAG##vector($input))
+	 scm_wrong_type_arg(FUNC_NAME, $argnum, $input);
+       elements = (const C_TYPE *) scm_##TAG##vector_elements($input, &handle, &len, &inc);
+       if (inc == 1) {
+	 $1.assign(elements, elements + len);
+       } else {
+	 $1.reserve(len);
+	 for (i = 0; i < len; i++)
+	   $1.push_back(elements[i * inc]);
+       }
+       scm_array_handle_release(&handle);
+     }
+
+     %typemap(in, doc="$NAME is a " #TAG "vector") const std::vector< C_TYPE > &UVECTOR (std::vector< C_TYPE > temp) {
+       scm_t_array_handle handle;
+       size_t len, i;
+       ssize_t inc;
+       const C_TYPE *elements;
+       if (!scm_is_##TAG##vector($input))
+	 scm_wrong_type_arg(FUNC_NAME, $argnum, $input);
+       elements = (const C_TYPE *) scm_##TAG##vector_elements($input, &handle, &len, &inc);
+       if (inc == 1) {
+	 temp.assign(elements, elements + len);
+       } else {
+	 temp.reserve(len);
+	 for (i = 0; i < len; i++)
+	   temp.push_back(elements[i * inc]);
+       }
+       scm_array_handle_release(&handle);
+       $1 = &temp;
+     }
+
+     %typemap(out, doc="<" #TAG "vector>") std::vector< C_TYPE > UVECTOR {
+       scm_t_array_handle handle;
+       size_t len;
+       ssize_t inc;
+       $result = scm_make_##TAG##vector(scm_from_size_t($1.size()), SCM_UNDEFINED);
+       if (!$1.empty()) {
+	 C_TYPE *elements = (C_TYPE *) scm_##TAG##vector_writable_elements($result, &handle, &len, &inc);
+	 memcpy(elements, &$1[0], len * sizeof(C_TYPE));
+	 scm_array_handle_release(&handle);
+       }
+     }
+
+#endif
+
+%enddef
+
+%{
+#include <string.h>
+%}
+
+#ifdef __cplusplus
+%{
+#include <vector>
+%}
+#endif
+
+TYPEMAP_UNIFORM_VECTOR(signed char, s8, scm_t_int8, SWIG_TYPECHECK_INT8_ARRAY);
+TYPEMAP_UNIFORM_VECTOR(unsigned char, u8, scm_t_uint8, SWIG_TYPECHECK_INT8_ARRAY);
+TYPEMAP_UNIFORM_VECTOR(short, s16, scm_t_int16, SWIG_TYPECHECK_INT16_ARRAY);
+TYPEMAP_UNIFORM_VECTOR(unsigned short, u16, scm_t_uint16, SWIG_TYPECHECK_INT16_ARRAY);
+TYPEMAP_UNIFORM_VECTOR(int, s32, scm_t_int32, SWIG_TYPECHECK_INT32_ARRAY);
+TYPEMAP_UNIFORM_VECTOR(unsigned int, u32, scm_t_uint32, SWIG_TYPECHECK_INT32_ARRAY);
+TYPEMAP_UNIFORM_VECTOR(long long, s64, scm_t_int64, SWIG_TYPECHECK_INT64_ARRAY);
+TYPEMAP_UNIFORM_VECTOR(unsigned long long, u64, scm_t_uint64, SWIG_TYPECHECK_INT64_ARRAY);
+TYPEMAP_UNIFORM_VECTOR(float, f32, float, SWIG_TYPECHECK_FLOAT_ARRAY);
+TYPEMAP_UNIFORM_VECTOR(double, f64, double, SWIG_TYPECHECK_DOUBLE_ARRAY);
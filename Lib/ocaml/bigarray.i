@@ -0,0 +1,118 @@
+/* -----------------------------------------------------------------------------
+ * bigarray.i
+ *
+ * Typemaps for passing arrays as OCaml Bigarrays to direct externals
+ * ----------------------------------------------------------------------------- */
+
+/* These typemaps only apply to the _<name>_direct externals generated for
+   functions with the ocaml:direct feature (see %ocamldirect), as a c_obj
+   cannot hold a Bigarray.
+
+   %ocaml_bigarray_typemaps(C_TYPE, MLTYPE, KIND)
+
+   MLTYPE is the OCaml type of the Bigarray, eg
+   "(float, Bigarray.float64_elt, Bigarray.c_layout) Bigarray.Array1.t",
+   and KIND the matching C kind, eg CAML_BA_FLOAT64.
+
+   Supported calling conventions:
+
+   func([const] C_TYPE *BIGARRAY, int LENGTH)
+   func(int LENGTH, [const] C_TYPE *BIGARRAY)
+
+       The OCaml external takes one argument, a one dimensional Bigarray
+       in C layout.  The C function is passed the address of the Bigarray
+       data and its length; nothing is copied, so changes made by the C
+       function are visible in OCaml.
+
+   const std::vector<C_TYPE> &BIGARRAY
+
+       In C++, the Bigarray is copied into a temporary std::vector.
+
+   std::vector<C_TYPE> BIGARRAY
+
+       A returned std::vector is copied into a new Bigarray.
+
+   std::vector<C_TYPE> &BIGARRAY
+   const std::vector<C_TYPE> &BIGARRAY
+
+       A returned reference to a std::vector becomes a Bigarray sharing its
+       storage, without copying.  The Bigarray must not be used after the
+       std::vector has been resized or destroyed.
+
+   It is also allowed to use "size_t" lengths rather than "int".  */
+
+%define %ocaml_bigarray_typemaps(C_TYPE, MLTYPE, KIND)
+
+%typemap(mltype, ctype="CAML_VALUE")
+  (C_TYPE *BIGARRAY, int LENGTH), (C_TYPE *BIGARRAY, size_t LENGTH),
+  (const C_TYPE *BIGARRAY, int LENGTH), (const C_TYPE *BIGARRAY, size_t LENGTH),
+  (int LENGTH, C_TYPE *BIGARRAY), (size_t LENGTH, C_TYPE *BIGARRAY),
+  (int LENGTH, const C_TYPE *BIGARRAY), (size_t LENGTH, const C_TYPE *BIGARRAY)
+  MLTYPE
+
+%typemap(directin)
+  (C_TYPE *BIGARRAY, int LENGTH), (C_TYPE *BIGARRAY, size_t LENGTH),
+  (const C_TYPE *BIGARRAY, int LENGTH), (const C_TYPE *BIGARRAY, size_t LENGTH)
+%{
+  $1 = ($1_ltype)Caml_ba_data_val($input);
+  $2 = ($2_ltype)Caml_ba_array_val($input)->dim[0];
+%}
+
+%typemap(directin)
+  (int LENGTH, C_TYPE *BIGARRAY), (size_t LENGTH, C_TYPE *BIGARRAY),
+  (int LENGTH, const C_TYPE *BIGARRAY), (size_t LENGTH, const C_TYPE *BIGARRAY)
+%{
+  $1 = ($1_ltype)Caml_ba_array_val($input)->dim[0];
+  $2 = ($2_ltype)Caml_ba_data_val($input);
+%}
+
+#ifdef __cplusplus
+
+%typemap(directin) const std::vector< C_TYPE > &BIGARRAY (std::vector< C_TYPE > temp) {
+  const C_TYPE *data = (const C_TYPE *)Caml_ba_data_val($input);
+  temp.assign(data, data + Caml_ba_array_val($input)->dim[0]);
+  $1 = &temp;
+}
+
+%typemap(mltype, ctype="CAML_VALUE", alloc="1") std::vector< C_TYPE > BIGARRAY, std::vector< C_TYPE > &BIGARRAY, const std::vector< C_TYPE > &BIGARRAY
+  MLTYPE
+
+%typemap(directout) std::vector< C_TYPE > BIGARRAY {
+  $result = caml_ba_alloc_dims(KIND | CAML_BA_C_LAYOUT, 1, NULL, (intnat)$1.size());
+  if (!$1.empty())
+    memcpy(Caml_ba_data_val($result), &$1[0], $1.size() * sizeof(C_TYPE));
+}
+
+%typemap(directout) std::vector< C_TYPE > &BIGARRAY, const std::vector< C_TYPE > &BIGARRAY {
+  $result = caml_ba_alloc_dims(KIND | CAML_BA_C_LAYOUT | CAML_BA_EXTERNAL, 1, $1->empty() ? NULL : (void *)&(*$1)[0], (intnat)$1->size());
+}
+
+#endif
+
+%enddef
+
+%{
+#include <string.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <caml/bigarray.h>
+#ifdef __cplusplus
+}
+#endif
+%}
+
+#ifdef __cplusplus
+%{
+#include <vector>
+%}
+#endif
+
+%ocaml_bigarray_typemaps(signed char, "(int, Bigarray.int8_signed_elt, Bigarray.c_layout) Bigarray.Array1.t", CAML_BA_SINT8);
+%ocaml_bigarray_typemaps(unsigned char, "(int, Bigarray.int8_unsigned_elt, Bigarray.c_layout) Bigarray.Array1.t", CAML_BA_UINT8);
+%ocaml_bigarray_typemaps(short, "(int, Bigarray.int16_signed_elt, Bigarray.c_layout) Bigarray.Array1.t", CAML_BA_SINT16);
+%ocaml_bigarray_typemaps(unsigned short, "(int, Bigarray.int16_unsigned_elt, Bigarray.c_layout) Bigarray.Array1.t", CAML_BA_UINT16);
+%ocaml_bigarray_typemaps(int, "(int32, Bigarray.int32_elt, Bigarray.c_layout) Bigarray.Array1.t", CAML_BA_INT32);
+%ocaml_bigarray_typemaps(long long, "(int64, Bigarray.int64_elt, Bigarray.c_layout) Bigarray.Array1.t", CAML_BA_INT64);
+%ocaml_bigarray_typemaps(float, "(float, Bigarray.float32_elt, Bigarray.c_layout) Bigarray.Array1.t", CAML_BA_FLOAT32);
+%ocaml_bigarray_typemaps(double, "(float, Bigarray.float64_elt, Bigarray.c_layout) Bigarray.Array1.t", CAML_BA_FLOAT64);
@@ -0,0 +1,14 @@
+/*
+ * Matrix typemaps
+ *
+ */
+
+%include <octmatrix.swg>
+
+%{
+#include <vector>
+%}
+
+%octave_matrix_typemaps(double, NDArray, double, array_value, SWIG_TYPECHECK_DOUBLE_ARRAY)
+%octave_matrix_typemaps(float, FloatNDArray, float, float_array_value, SWIG_TYPECHECK_FLOAT_ARRAY)
+%octave_matrix_typemaps(int, int32NDArray, octave_int32, int32_array_value, SWIG_TYPECHECK_INT32_ARRAY)
@@ -0,0 +1,59 @@
+/* -----------------------------------------------------------------------------
+ * std_string_view.i
+ *
+ * SWIG typemaps for std::string_view types (requires C++17)
+ * ----------------------------------------------------------------------------- */
+
+// ------------------------------------------------------------------------
+// std::string_view is typemapped by value.  Input strings are not copied:
+// the string_view refers directly to the buffer of the zend_string, which
+// stays alive for the duration of the call.  The wrapped function must not
+// keep the string_view after it returns.
+// ------------------------------------------------------------------------
+
+%{
+#include <string_view>
+%}
+
+namespace std {
+
+    %naturalvar string_view;
+
+    class string_view;
+
+    %typemap(typecheck,precedence=SWIG_TYPECHECK_STRING) string_view, const string_view& %{
+        $1 = (Z_TYPE($input) == IS_STRING) ? 1 : 0;
+    %}
+
+    %typemap(in) string_view %{
+        convert_to_string(&$input);
+        $1 = std::string_view(Z_STRVAL($input), Z_STRLEN($input));
+    %}
+
+    %typemap(in) const string_view & ($*1_ltype temp) %{
+        convert_to_string(&$input);
+        temp = std::string_view(Z_STRVAL($input), Z_STRLEN($input));
+        $1 = &temp;
+    %}
+
+    %typemap(out) string_view %{
+        ZVAL_STRINGL($result, $1.data(), $1.size());
+    %}
+
+    %typemap(out) const string_view & %{
+        ZVAL_STRINGL($result, $1->data(), $1->size());
+    %}
+
+    %typemap(directorin) string_view, const string_view& %{
+        ZVAL_STRINGL($input, $1.data(), $1.size());
+    %}
+
+    %typemap(throws) string_view, const string_view& %{
+        {
+          zend_string *msg = zend_string_init($1.data(), $1.size(), 0);
+          zend_throw_exception(NULL, ZSTR_VAL(msg), 0);
+          zend_string_release(msg);
+        }
+        return;
+    %}
+}
@@ -9,8 +9,21 @@ namespace std {
     class map {
      public:
         %extend {
-            _V get(const _K& k){
-                return (*self)[k];
+            /* Returns a default constructed value if there is no entry for k,
+               without inserting one. */
+            _V get(const _K& k) const {
+                auto it = self->find(k);
+                return it != self->end() ? it->second : _V();
+            }
+
+            bool has(const _K& k) const {
+                return self->find(k) != self->end();
+            }
+
+            /* Returns undefined if there is no entry for k. */
+            val find(const _K& k) const {
+                auto it = self->find(k);
+                return it != self->end() ? val(it->second) : val::undefined();
             }
             void set(const _K& k, const _V& val) {
                 (*self)[k] = val;
@@ -0,0 +1,109 @@
+/* -----------------------------------------------------------------------------
+ * std_string.i
+ *
+ * Strings for functions exported with -wasm-rawabi.  Including this file lets
+ * functions taking or returning std::string, const std::string &,
+ * std::string_view and const char * use the raw ABI.  Without -wasm-rawabi,
+ * which defines SWIGWASM_RAWABI, the file adds nothing and strings are
+ * converted by embind.
+ *
+ * Arguments are encoded with TextEncoder.encodeInto directly into a scratch
+ * region of the wasm heap, which is allocated once and reused by every call.
+ * A string that does not fit into what is left of the scratch region is
+ * written to memory from _malloc instead, which is freed when the call
+ * returns.  Results are decoded with TextDecoder from a view of the heap.
+ * _malloc and _free must be exported, eg with
+ * -sEXPORTED_FUNCTIONS=_malloc,_free.
+ * ----------------------------------------------------------------------------- */
+
+#ifdef SWIGWASM_RAWABI
+
+%{
+#include <string>
+#include <string.h>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+/* The result of an export returning a string. */
+struct swig_wasm_string {
+    const char *data;
+    size_t length;
+};
+
+static swig_wasm_string swig_wasm_string_out;
+
+/* A std::string result by value, kept until the next string result. */
+static std::string swig_wasm_string_value;
+
+static swig_wasm_string *swig_wasm_string_result(const char *data, size_t length) {
+    swig_wasm_string_out.data = data;
+    swig_wasm_string_out.length = length;
+    return &swig_wasm_string_out;
+}
+%}
+
+%fragment ("emwasm_js_strings", "templates")
+%{
+// The size of the scratch region for string arguments, in bytes.
+const __swig_string_scratch_size = 16384;
+const __swig_string_encoder = new TextEncoder();
+const __swig_string_decoder = new TextDecoder();
+let __swig_string_scratch = 0;
+let __swig_string_scratch_used = 0;
+let __swig_string_allocs = [];
+// The length in bytes of the string last written by __swig_string_in().
+let __swig_string_length = 0;
+
+// Releases the strings written since __swig_string_scratch_used and
+// __swig_string_allocs.length had the values given.
+function __swig_string_release(used, allocs) {
+    __swig_string_scratch_used = used;
+    while (__swig_string_allocs.length > allocs) {
+        _free(__swig_string_allocs.pop());
+    }
+}
+
+// Writes str to the wasm heap, NUL terminated, returning its address and
+// setting __swig_string_length.
+function __swig_string_in(str) {
+    if (str === null || str === undefined) {
+        __swig_string_length = 0;
+        return 0;
+    }
+    if (typeof str !== 'string') {
+        throw new TypeError('Expected a string');
+    }
+    // a UTF-16 code unit takes at most 3 bytes in UTF-8
+    const max = str.length * 3 + 1;
+    const in_scratch = max <= __swig_string_scratch_size - __swig_string_scratch_used;
+    let ptr;
+    if (in_scratch) {
+        if (!__swig_string_scratch) {
+            __swig_string_scratch = _malloc(__swig_string_scratch_size);
+        }
+        ptr = __swig_string_scratch + __swig_string_scratch_used;
+    } else {
+        ptr = _malloc(max);
+        __swig_string_allocs.push(ptr);
+    }
+    const written = __swig_string_encoder.encodeInto(str, HEAPU8.subarray(ptr, ptr + max - 1)).written;
+    HEAPU8[ptr + written] = 0;
+    if (in_scratch) {
+        __swig_string_scratch_used += written + 1;
+    }
+    __swig_string_length = written;
+    return ptr;
+}
+
+// Decodes the swig_wasm_string at result.
+function __swig_string_out(result) {
+    const data = HEAPU32[result >> 2];
+    if (!data) {
+        return null;
+    }
+    return __swig_string_decoder.decode(HEAPU8.subarray(data, data + HEAPU32[(result >> 2) + 1]));
+}
+%}
+
+#endif
@@ -1669,7 +1669,7 @@ static String *add_qualifier_to_declarator(SwigType *type, SwigType *qualifier)
 %type <p>        parm_no_dox parm valparm rawvalparms valparms valptail ;
 %type <p>        typemap_parm tm_list tm_tail ;
 %type <p>        templateparameter ;
-%type <id>       templcpptype cpptype classkey classkeyopt access_specifier;
+%type <id>       templcpptype cpptype classkey classkeyopt access_specifier opt_virtual;
 %type <node>     base_specifier;
 %type <str>      ellipsis variadic;
 %type <type>     type rawtype type_right anon_bitfield_type decltype ;
@@ -6843,6 +6843,8 @@ base_specifier : opt_virtual {
 		 }
 		 if ($4)
 		   SetFlag($$, "variadic");
+		 if ($1)
+		   Setmeta($3, "virtual", "1");
                }
 	       | opt_virtual access_specifier {
 		 $<intvalue>$ = cparse_line;
@@ -6859,6 +6861,8 @@ base_specifier : opt_virtual {
 		 }
 		 if ($6)
 		   SetFlag($$, "variadic");
+		 if ($1 || $4)
+		   Setmeta($5, "virtual", "1");
                }
                ;
 
@@ -6920,8 +6924,8 @@ classkeyopt    : classkey {
                }
                ;
 
-opt_virtual    : VIRTUAL
-               | empty
+opt_virtual    : VIRTUAL { $$ = (char*)"virtual"; }
+               | empty { $$ = 0; }
                ;
 
 virt_specifier_seq : OVERRIDE {
@@ -244,6 +244,7 @@
 #define WARN_D_CANTHROW_MISSING               711
 #define WARN_D_NO_DIRECTORCONNECT_ATTR        712
 #define WARN_D_NAME_COLLISION                 713
+#define WARN_D_NOGC_IGNORED                   714
 
 /* please leave 700-719 free for D */
 
@@ -255,6 +256,14 @@
 
 /* please leave 740-759 free for Python */
 
+#define WARN_R_VECTORIZE_IGNORED              760
+
+/* please leave 760-779 free for R */
+
+#define WARN_OCAML_DIRECT_IGNORED             780
+
+/* please leave 780-799 free for OCaml */
+
 #define WARN_RUBY_WRONG_NAME                  801
 #define WARN_RUBY_MULTIPLE_INHERITANCE        802
 
@@ -297,6 +306,8 @@
 #define WARN_CSHARP_EXCODE                    844
 #define WARN_CSHARP_CANTHROW                  845
 #define WARN_CSHARP_NO_DIRECTORCONNECT_ATTR   846
+#define WARN_CSHARP_BLITTABLE_MEMBER          847
+#define WARN_CSHARP_FASTCALL_IGNORED          848
 
 /* please leave 830-849 free for C# */
 
@@ -321,6 +332,8 @@
 /* please leave 870-889 free for PHP */
 
 #define WARN_GO_NAME_CONFLICT                 890
+#define WARN_GO_BATCH_IGNORED                 891
+#define WARN_GO_ARENA_IGNORED                 892
 
 /* please leave 890-899 free for Go */
 
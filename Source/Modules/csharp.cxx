@@ -46,6 +46,7 @@ class CSHARP:public Language {
   bool global_variable_flag;	// Flag for when wrapping a global variable
   bool old_variable_names;	// Flag for old style variable names in the intermediary class
   bool generate_property_declaration_flag;	// Flag for generating properties
+  bool native_library_flag;	// Flag for when the intermediary class needs the SWIGNativeLibrary helper for function pointers
 
   String *imclass_name;		// intermediary class name
   String *module_class_name;	// module class name
@@ -122,6 +123,7 @@ public:
       global_variable_flag(false),
       old_variable_names(false),
       generate_property_declaration_flag(false),
+      native_library_flag(false),
       imclass_name(NULL),
       module_class_name(NULL),
       imclass_class_code(NULL),
@@ -468,6 +470,17 @@ public:
 	Printv(f_im, "implements ", imclass_interfaces, " ", NIL);
       Printf(f_im, "{\n");
 
+      if (native_library_flag) {
+	// Native library handle used to resolve the %csfunctionpointer entry points
+	Printv(imclass_class_code,
+	       "\n  protected static class SWIGNativeLibrary {\n",
+	       "    private static readonly global::System.IntPtr handle = global::System.Runtime.InteropServices.NativeLibrary.Load(\"$dllimport\", typeof($imclassname).Assembly, null);\n\n",
+	       "    public static global::System.IntPtr GetExport(string name) {\n",
+	       "      return global::System.Runtime.InteropServices.NativeLibrary.GetExport(handle, name);\n",
+	       "    }\n",
+	       "  }\n", NIL);
+      }
+
       // Add the intermediary class methods
       Replaceall(imclass_class_code, "$module", module_class_name);
       Replaceall(imclass_class_code, "$imclassname", imclass_name);
@@ -814,6 +827,7 @@ public:
       String *imtypeout = Getattr(n, "tmap:imtype:out");	// the type in the imtype typemap's out attribute overrides the type in the typemap
       if (imtypeout)
 	tm = imtypeout;
+      substituteBlittableClassname(t, tm);
       Printf(im_return_type, "%s", tm);
       im_outattributes = Getattr(n, "tmap:imtype:outattributes");
     } else {
@@ -846,13 +860,13 @@ public:
       }
     }
 
-    Printv(imclass_class_code, "\n  [global::System.Runtime.InteropServices.DllImport(\"", dllimport, "\", EntryPoint=\"", wname, "\")]\n", NIL);
-
-    if (im_outattributes)
-      Printf(imclass_class_code, "  %s\n", im_outattributes);
-
-    Printf(imclass_class_code, "  public static extern %s %s(", im_return_type, overloaded_name);
-
+    // The intermediary class declaration is written out once the wrapper code is known as
+    // %cssuppressgctransition and %csfunctionpointer depend on what the wrapper calls
+    String *im_params = NewString("");
+    String *fnptr_types = NewString("");
+    String *fnptr_args = NewString("");
+    String *fnptr_keepalive = NewString("");
+    String *fnptr_unsupported = 0;
 
     /* Get number of required and total arguments */
     num_arguments = emit_num_arguments(l);
@@ -883,15 +897,32 @@ public:
       /* Get the intermediary class parameter types of the parameter */
       if ((tm = Getattr(p, "tmap:imtype"))) {
 	const String *inattributes = Getattr(p, "tmap:imtype:inattributes");
+	substituteBlittableClassname(pt, tm);
 	Printf(im_param_type, "%s%s", inattributes ? inattributes : empty_string, tm);
+
+	if (!fnptr_unsupported) {
+	  String *fnptr_type = inattributes ? 0 : functionPointerType(tm);
+	  if (fnptr_type) {
+	    Printf(fnptr_types, "%s, ", fnptr_type);
+	    if (Strcmp(fnptr_type, tm) == 0) {
+	      Printf(fnptr_args, "%s%s", gencomma ? ", " : "", arg);
+	    } else {
+	      Printf(fnptr_args, "%s%s.Handle", gencomma ? ", " : "", arg);
+	      Printf(fnptr_keepalive, "    global::System.GC.KeepAlive(%s.Wrapper);\n", arg);
+	    }
+	    Delete(fnptr_type);
+	  } else {
+	    fnptr_unsupported = im_param_type;
+	  }
+	}
       } else {
 	Swig_warning(WARN_CSHARP_TYPEMAP_CSTYPE_UNDEF, input_file, line_number, "No imtype typemap defined for %s\n", SwigType_str(pt, 0));
       }
 
       /* Add parameter to intermediary class method */
       if (gencomma)
-	Printf(imclass_class_code, ", ");
-      Printf(imclass_class_code, "%s %s", im_param_type, arg);
+	Printf(im_params, ", ");
+      Printf(im_params, "%s %s", im_param_type, arg);
 
       // Add parameter to C function
       Printv(f->def, gencomma ? ", " : "", c_param_type, " ", arg, NIL);
@@ -912,7 +943,8 @@ public:
 	Swig_warning(WARN_TYPEMAP_IN_UNDEF, input_file, line_number, "Unable to use type %s as a function argument.\n", SwigType_str(pt, 0));
 	p = nextSibling(p);
       }
-      Delete(im_param_type);
+      if (im_param_type != fnptr_unsupported)
+	Delete(im_param_type);
       Delete(c_param_type);
       Delete(arg);
     }
@@ -1025,10 +1057,7 @@ public:
       }
     }
 
-    /* Finish C function and intermediary class function definitions */
-    Printf(imclass_class_code, ")");
-    Printf(imclass_class_code, ";\n");
-
+    /* Finish C function definition */
     Printf(f->def, ") {");
 
     if (!is_void_return)
@@ -1074,6 +1103,61 @@ public:
       }
     }
 
+    /* Intermediary class function declaration */
+    bool suppress_gc_transition = false;
+    if (GetFlag(n, "feature:cs:suppressgctransition")) {
+      // The runtime stays in cooperative mode for the call, so the unmanaged code must not call back into managed code
+      const char *reason = 0;
+      if (Getattr(n, "csharp:canthrow"))
+	reason = "it can throw a C# exception";
+      else if (Strstr(f->code, "SWIG_csharp_string_callback"))
+	reason = "it returns a string via the SWIGStringHelper callback";
+      else if (directorsEnabled() && is_wrapping_class() && Swig_directorclass(n))
+	reason = "it can call a director method";
+      if (reason)
+	Swig_warning(WARN_CSHARP_FASTCALL_IGNORED, input_file, line_number, "%%cssuppressgctransition ignored for %s as %s.\n", symname, reason);
+      else
+	suppress_gc_transition = true;
+    }
+
+    String *fnptr_return_type = is_void_return ? NewString("void") : functionPointerType(im_return_type);
+    bool function_pointer = false;
+    if (GetFlag(n, "feature:cs:functionpointer")) {
+      String *unsupported = fnptr_unsupported;
+      if (!unsupported && (!fnptr_return_type || Strcmp(fnptr_return_type, im_return_type) != 0 || im_outattributes))
+	unsupported = im_return_type;
+      if (unsupported)
+	Swig_warning(WARN_CSHARP_FASTCALL_IGNORED, input_file, line_number, "%%csfunctionpointer ignored for %s as the intermediary type %s is not blittable.\n", symname, unsupported);
+      else
+	function_pointer = true;
+    }
+
+    if (function_pointer) {
+      // Call through an unmanaged function pointer resolved once from the native library
+      native_library_flag = true;
+      Printv(imclass_class_code, "\n  private static readonly global::System.IntPtr swigFnPtr_", overloaded_name, " = SWIGNativeLibrary.GetExport(\"", wname, "\");\n", NIL);
+      Printf(imclass_class_code, "  public static unsafe %s %s(%s) {\n", im_return_type, overloaded_name, im_params);
+      String *fnptr_call = NewStringf("((delegate* unmanaged%s<%s%s>)swigFnPtr_%s)(%s)",
+				     suppress_gc_transition ? "[SuppressGCTransition]" : "",
+				     fnptr_types, fnptr_return_type, overloaded_name, fnptr_args);
+      if (is_void_return) {
+	Printv(imclass_class_code, "    ", fnptr_call, ";\n", fnptr_keepalive, NIL);
+      } else if (Len(fnptr_keepalive) > 0) {
+	Printv(imclass_class_code, "    ", im_return_type, " ret = ", fnptr_call, ";\n", fnptr_keepalive, "    return ret;\n", NIL);
+      } else {
+	Printv(imclass_class_code, "    return ", fnptr_call, ";\n", NIL);
+      }
+      Printf(imclass_class_code, "  }\n");
+      Delete(fnptr_call);
+    } else {
+      Printv(imclass_class_code, "\n  [global::System.Runtime.InteropServices.DllImport(\"", dllimport, "\", EntryPoint=\"", wname, "\")]\n", NIL);
+      if (suppress_gc_transition)
+	Printf(imclass_class_code, "  [global::System.Runtime.InteropServices.SuppressGCTransition]\n");
+      if (im_outattributes)
+	Printf(imclass_class_code, "  %s\n", im_outattributes);
+      Printf(imclass_class_code, "  public static extern %s %s(%s);\n", im_return_type, overloaded_name, im_params);
+    }
+
     if (!(proxy_flag && is_wrapping_class()) && !enum_constant_flag) {
       moduleClassFunctionHandler(n);
     }
@@ -1101,6 +1185,12 @@ public:
       Delete(getter_setter_name);
     }
 
+    Delete(fnptr_return_type);
+    Delete(fnptr_unsupported);
+    Delete(fnptr_keepalive);
+    Delete(fnptr_args);
+    Delete(fnptr_types);
+    Delete(im_params);
     Delete(c_return_type);
     Delete(im_return_type);
     Delete(cleanup);
@@ -2044,6 +2134,165 @@ public:
     Delete(smart);
   }
 
+  /* ----------------------------------------------------------------------
+   * blittableFieldType()
+   *
+   * Returns the C# type of a field in a blittable struct or NULL if the C++ type
+   * does not have an identical layout in C#. Sets fixed_size to the number of
+   * elements for fixed size arrays of primitive types.
+   * ---------------------------------------------------------------------- */
+
+  String *blittableFieldType(SwigType *t, String **fixed_size) {
+    static const char *fixed_width_types[][2] = {
+      {"int8_t", "sbyte"}, {"uint8_t", "byte"}, {"int16_t", "short"}, {"uint16_t", "ushort"},
+      {"int32_t", "int"}, {"uint32_t", "uint"}, {"int64_t", "long"}, {"uint64_t", "ulong"}
+    };
+    String *cstype = 0;
+    SwigType *type = SwigType_strip_qualifiers(t);
+
+    if (SwigType_isarray(type)) {
+      String *dim = SwigType_array_getdim(type, 0);
+      if (SwigType_array_ndim(type) == 1 && dim && Len(dim) > 0) {
+	SwigType *elemtype = SwigType_array_type(type);
+	// C# fixed size buffers can only hold primitive types
+	if (!SwigType_isenum(elemtype) && !classLookup(elemtype)) {
+	  cstype = blittableFieldType(elemtype, 0);
+	  if (cstype && fixed_size)
+	    *fixed_size = Copy(dim);
+	}
+	Delete(elemtype);
+      }
+      Delete(dim);
+      Delete(type);
+      return cstype;
+    }
+
+    for (size_t i = 0; i < sizeof(fixed_width_types) / sizeof(fixed_width_types[0]); i++) {
+      if (Strcmp(type, fixed_width_types[i][0]) == 0) {
+	Delete(type);
+	return NewString(fixed_width_types[i][1]);
+      }
+    }
+
+    SwigType *resolved = SwigType_typedef_resolve_all(type);
+    SwigType *stripped = SwigType_strip_qualifiers(resolved);
+    switch (SwigType_type(stripped)) {
+      case T_UCHAR:
+	cstype = NewString("byte");
+	break;
+      case T_CHAR:
+      case T_SCHAR:
+	// char is signed on the common platforms, but its layout is the same either way
+	cstype = NewString("sbyte");
+	break;
+      case T_SHORT:
+	cstype = NewString("short");
+	break;
+      case T_USHORT:
+	cstype = NewString("ushort");
+	break;
+      case T_INT:
+	cstype = NewString("int");
+	break;
+      case T_UINT:
+	cstype = NewString("uint");
+	break;
+      case T_LONGLONG:
+	cstype = NewString("long");
+	break;
+      case T_ULONGLONG:
+	cstype = NewString("ulong");
+	break;
+      case T_FLOAT:
+	cstype = NewString("float");
+	break;
+      case T_DOUBLE:
+	cstype = NewString("double");
+	break;
+      case T_USER:
+	{
+	  // Nested blittable structs
+	  Node *cls = classLookup(stripped);
+	  if (cls && GetFlag(cls, "feature:cs:blittable"))
+	    cstype = Copy(getProxyName(stripped));
+	}
+	break;
+      default:
+	// bool, wchar_t and long are not blittable or vary in size across platforms
+	break;
+    }
+    Delete(stripped);
+    Delete(resolved);
+    Delete(type);
+    return cstype;
+  }
+
+  /* ----------------------------------------------------------------------
+   * emitBlittableStructDef()
+   *
+   * Emits a C# value type mirroring the memory layout of a POD struct marked
+   * with the cs:blittable feature in place of the usual proxy class.
+   * ---------------------------------------------------------------------- */
+
+  void emitBlittableStructDef(Node *n) {
+    // Prefer the typedef name for C structs as used in %csblittable(TYPE) so that the struct typemaps are found
+    SwigType *typemap_lookup_type = Getattr(n, "tdname") ? Getattr(n, "tdname") : Getattr(n, "classtypeobj");
+    bool has_outerclass = Getattr(n, "nested:outer") != 0 && !GetFlag(n, "feature:flatnested");
+
+    if (Getattr(n, "bases"))
+      Swig_error(Getfile(n), Getline(n), "Blittable struct %s cannot have base classes.\n", proxy_class_name);
+    if (Swig_directorclass(n) || Getattr(n, "feature:interface"))
+      Swig_error(Getfile(n), Getline(n), "Blittable struct %s cannot use the director or interface features.\n", proxy_class_name);
+
+    if (!has_outerclass)
+      Printv(proxy_class_def, typemapLookup(n, "csimports", typemap_lookup_type, WARN_NONE), "\n", NIL);
+    const String *csattributes = typemapLookup(n, "csattributes", typemap_lookup_type, WARN_NONE);
+    if (csattributes && *Char(csattributes))
+      Printf(proxy_class_def, "%s\n", csattributes);
+    Printv(proxy_class_def, typemapLookup(n, "csclassmodifiers", typemap_lookup_type, WARN_CSHARP_TYPEMAP_CLASSMOD_UNDEF), " $csclassname {\n", NIL);
+
+    for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+      String *nodetype = nodeType(c);
+      if (Equal(nodetype, "constructor") || Equal(nodetype, "destructor") || Equal(nodetype, "access"))
+	continue;
+      if (!Equal(nodetype, "cdecl") || GetFlag(c, "feature:ignore"))
+	continue;
+      String *symname = Getattr(c, "sym:name") ? Getattr(c, "sym:name") : Getattr(c, "name");
+      if (SwigType_isfunction(Getattr(c, "decl"))) {
+	if (Equal(Getattr(c, "storage"), "virtual"))
+	  Swig_error(Getfile(c), Getline(c), "Blittable struct %s cannot have virtual methods.\n", proxy_class_name);
+	else
+	  Swig_warning(WARN_CSHARP_BLITTABLE_MEMBER, Getfile(c), Getline(c), "Member %s of blittable struct %s ignored.\n", symname, proxy_class_name);
+	continue;
+      }
+      if (Swig_storage_isstatic(c)) {
+	Swig_warning(WARN_CSHARP_BLITTABLE_MEMBER, Getfile(c), Getline(c), "Member %s of blittable struct %s ignored.\n", symname, proxy_class_name);
+	continue;
+      }
+      SwigType *type = Copy(Getattr(c, "type"));
+      SwigType_push(type, Getattr(c, "decl"));
+      String *fixed_size = 0;
+      String *cstype = Getattr(c, "bitfield") ? 0 : blittableFieldType(type, &fixed_size);
+      if (!cstype) {
+	Swig_error(Getfile(c), Getline(c), "Member %s of type %s in blittable struct %s is not blittable.\n", symname, SwigType_str(type, 0), proxy_class_name);
+	Delete(type);
+	continue;
+      }
+      // Non-public members still occupy storage and so are always emitted
+      const char *access = is_public(c) ? "public" : "private";
+      if (fixed_size)
+	Printf(proxy_class_code, "  %s unsafe fixed %s %s[%s];\n", access, cstype, symname, fixed_size);
+      else
+	Printf(proxy_class_code, "  %s %s %s;\n", access, cstype, symname);
+      Delete(fixed_size);
+      Delete(cstype);
+      Delete(type);
+    }
+
+    // Emit extra user code
+    Printv(proxy_class_code, typemapLookup(n, "cscode", typemap_lookup_type, WARN_NONE), NIL);
+  }
+
   /* ----------------------------------------------------------------------
    * emitInterfaceDeclaration()
    * ---------------------------------------------------------------------- */
@@ -2171,11 +2420,16 @@ public:
       }
     }
 
-    Language::classHandler(n);
+    bool blittable = proxy_flag && GetFlag(n, "feature:cs:blittable");
+    if (blittable)
+      emitBlittableStructDef(n);
+    else
+      Language::classHandler(n);
 
     if (proxy_flag) {
 
-      emitProxyClassDefAndCPPCasts(n);
+      if (!blittable)
+	emitProxyClassDefAndCPPCasts(n);
 
       String *csclazzname = Swig_name_member(getNSpace(), getClassPrefix(), ""); // mangled full proxy class name
 
@@ -3349,6 +3603,28 @@ public:
     return enumname;
   }
 
+  /* -----------------------------------------------------------------------------
+   * functionPointerType()
+   *
+   * Returns the type to use in an unmanaged function pointer signature for the given
+   * intermediary class type or NULL if the type is not blittable and needs the
+   * P/Invoke marshaller. A HandleRef is passed as its IntPtr handle.
+   * ----------------------------------------------------------------------------- */
+
+  String *functionPointerType(String *imtype) {
+    static const char *blittable_types[] = {
+      "byte", "sbyte", "short", "ushort", "int", "uint", "long", "ulong", "float", "double",
+      "global::System.IntPtr", "global::System.UIntPtr", 0
+    };
+    for (int i = 0; blittable_types[i]; i++) {
+      if (Strcmp(imtype, blittable_types[i]) == 0)
+	return NewString(imtype);
+    }
+    if (Strcmp(imtype, "global::System.Runtime.InteropServices.HandleRef") == 0)
+      return NewString("global::System.IntPtr");
+    return 0;
+  }
+
   /* -----------------------------------------------------------------------------
    * substituteClassname()
    *
@@ -3443,6 +3719,20 @@ public:
     return substitution_performed;
   }
 
+  /* -----------------------------------------------------------------------------
+   * substituteBlittableClassname()
+   *
+   * The imtype typemaps of blittable structs use the C# struct itself, so
+   * $csclassname is substituted in them. It is left alone in other imtype
+   * typemaps, as before.
+   * ----------------------------------------------------------------------------- */
+
+  void substituteBlittableClassname(SwigType *pt, String *tm) {
+    Node *cls = classLookup(pt);
+    if (cls && GetFlag(cls, "feature:cs:blittable"))
+      substituteClassname(pt, tm);
+  }
+
   /* -----------------------------------------------------------------------------
    * substituteClassnameSpecialVariable()
    * ----------------------------------------------------------------------------- */
@@ -3897,6 +4187,7 @@ public:
       String *imtypeout = Getattr(n, "tmap:imtype:out");	// the type in the imtype typemap's out attribute overrides the type in the typemap
       if (imtypeout)
 	tm = imtypeout;
+      substituteBlittableClassname(returntype, tm);
       const String *im_directoroutattributes = Getattr(n, "tmap:imtype:directoroutattributes");
       if (im_directoroutattributes) {
 	Printf(callback_def, "  %s\n", im_directoroutattributes);
@@ -4017,6 +4308,7 @@ public:
 	    String *imtypeout = Getattr(p, "tmap:imtype:out");	// the type in the imtype typemap's out attribute overrides the type in the typemap
 	    if (imtypeout)
 	      tm = imtypeout;
+	    substituteBlittableClassname(pt, tm);
             const String *im_directorinattributes = Getattr(p, "tmap:imtype:directorinattributes");
 
 	    String *din = Copy(Getattr(p, "tmap:csdirectorin"));
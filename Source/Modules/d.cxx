@@ -1770,11 +1770,8 @@ public:
       }
     }
 
-    // Complete D im parameter list and emit the declaration/binding code.
+    // Complete D im parameter list.
     Printv(im_dmodule_parameters, ")", NIL);
-    writeImDModuleFunction(overloaded_name, im_return_type,
-      im_dmodule_parameters, wname);
-    Delete(im_dmodule_parameters);
 
     // Finish C function header.
     Printf(f->def, ") {");
@@ -1824,6 +1821,15 @@ public:
       }
     }
 
+    // Emit the im declaration/binding code now that it is known whether the
+    // function can throw.
+    if (checkNoGC(n)) {
+      Setattr(n, "d:nogc", "1");
+    }
+    writeImDModuleFunction(overloaded_name, im_return_type,
+      im_dmodule_parameters, wname, Getattr(n, "d:nogc") != 0);
+    Delete(im_dmodule_parameters);
+
     // If we are not processing an enum or constant, and we were not generating
     // a wrapper function which will be accessed via a proxy class, write a
     // function to the proxy D module.
@@ -2602,6 +2608,73 @@ protected:
   }
 
 private:
+  /* ---------------------------------------------------------------------------
+   * D::checkNoGC()
+   *
+   * Returns whether the d:nogc feature can be used for the given function, so
+   * that its intermediary and proxy functions are marked nothrow @nogc. This
+   * requires D2, and the function must not throw D exceptions, as they are
+   * created and thrown by GC-allocating D code. The din and dout typemaps must
+   * not allocate either, which rules out e.g. class return values (new
+   * ClassName(...)) and the string conversions.
+   * --------------------------------------------------------------------------- */
+  bool checkNoGC(Node *n) {
+    if (!GetFlag(n, "feature:d:nogc"))
+      return false;
+
+    if (d_version == 1) {
+      Swig_warning(WARN_D_NOGC_IGNORED, input_file, line_number,
+	"Ignoring dnogc feature for %s, nothrow @nogc requires D2.\n", Swig_name_decl(n));
+      return false;
+    }
+    if (Getattr(n, "d:canthrow")) {
+      Swig_warning(WARN_D_NOGC_IGNORED, input_file, line_number,
+	"Ignoring dnogc feature for %s, the function can throw a D exception.\n", Swig_name_decl(n));
+      return false;
+    }
+
+    String *tm = lookupDTypemap(n, "dout");
+    bool allocates = tm && isGCAllocatingDCode(tm);
+    Delete(tm);
+    if (allocates) {
+      Swig_warning(WARN_D_NOGC_IGNORED, input_file, line_number,
+	"Ignoring dnogc feature for %s, the dout typemap for the return type allocates GC memory.\n", Swig_name_decl(n));
+      return false;
+    }
+
+    ParmList *l = Getattr(n, "parms");
+    Swig_typemap_attach_parms("din", l, NULL);
+    for (Parm *p = l; p; p = nextSibling(p)) {
+      if (checkAttribute(p, "tmap:in:numinputs", "0"))
+	continue;
+      String *din = Getattr(p, "tmap:din");
+      if (din && isGCAllocatingDCode(din)) {
+	Swig_warning(WARN_D_NOGC_IGNORED, input_file, line_number,
+	  "Ignoring dnogc feature for %s, the din typemap for %s allocates GC memory.\n",
+	  Swig_name_decl(n), SwigType_str(Getattr(p, "type"), Getattr(p, "name")));
+	return false;
+      }
+    }
+    return true;
+  }
+
+  /* ---------------------------------------------------------------------------
+   * D::isGCAllocatingDCode()
+   *
+   * Returns whether the given din/dout typemap code contains one of the
+   * constructs the standard typemaps allocate GC memory with.
+   * --------------------------------------------------------------------------- */
+  bool isGCAllocatingDCode(const String *code) {
+    static const char *const allocating[] = {
+      "new ", "toStringz", "to!string", "to!(string)", ".dup", ".idup", 0
+    };
+    for (int i = 0; allocating[i]; ++i) {
+      if (Strstr(code, allocating[i]))
+	return true;
+    }
+    return false;
+  }
+
   /* ---------------------------------------------------------------------------
    * D::writeImDModuleFunction()
    *
@@ -2613,14 +2686,15 @@ private:
    * parameters - The parameter list of the C wrapper function.
    * wrapper_function_name - The name of the exported function in the C wrapper
    *                         (usually d_name prefixed by »D_«).
+   * nogc - Whether the function pointer type is nothrow @nogc.
    * --------------------------------------------------------------------------- */
   void writeImDModuleFunction(const_String_or_char_ptr d_name,
     const_String_or_char_ptr return_type, const_String_or_char_ptr parameters,
-    const_String_or_char_ptr wrapper_function_name) {
+    const_String_or_char_ptr wrapper_function_name, bool nogc = false) {
 
     // TODO: Add support for static linking here.
-    Printf(im_dmodule_code, "SwigExternC!(%s function%s) %s;\n", return_type,
-      parameters, d_name);
+    Printf(im_dmodule_code, "%s!(%s function%s) %s;\n",
+      nogc ? "SwigExternCNoGC" : "SwigExternC", return_type, parameters, d_name);
     Printv(wrapper_loader_bind_code, wrapper_loader_bind_command, NIL);
     Replaceall(wrapper_loader_bind_code, "$function", d_name);
     Replaceall(wrapper_loader_bind_code, "$symbol", wrapper_function_name);
@@ -2833,6 +2907,10 @@ private:
     Printf(imcall, ")");
     Printf(function_code, ") ");
 
+    if (Getattr(n, "d:nogc")) {
+      Printf(function_code, "nothrow @nogc ");
+    }
+
     if (d_version > 1 && wrapping_member_flag) {
       Printf(function_code, "@property ");
     }
@@ -3067,6 +3145,10 @@ private:
     Printf(imcall, ")");
     Printf(function_code, ") ");
 
+    if (Getattr(n, "d:nogc")) {
+      Printf(function_code, "nothrow @nogc ");
+    }
+
     if (global_variable_flag && (d_version > 1)) {
       Printf(function_code, "@property ");
     }
@@ -179,6 +179,9 @@ class GO:public Language {
   // class.  This lets us detect base class methods that we don't want
   // to use.
   Hash *class_methods;
+  // The constructors with the go:arena feature seen when processing
+  // a class.
+  List *arena_constructors;
   // True when we are generating the wrapper functions for a variable.
   bool making_variable_wrappers;
   // True when working with a static member function.
@@ -236,6 +239,7 @@ public:
      class_name(NULL),
      class_receiver(NULL),
      class_methods(NULL),
+     arena_constructors(NULL),
      making_variable_wrappers(false),
      is_static_member_function(false),
      undefined_enum_types(NULL),
@@ -1005,6 +1009,184 @@ private:
     return r;
   }
 
+  /* ----------------------------------------------------------------------
+   * constructorHandler()
+   *
+   * Note the constructors with the go:arena feature.  Their arena
+   * versions are generated by emitArenaConstructors once all the
+   * constructors of the class have been seen, so that overloads can
+   * be dispatched among themselves.
+   * ---------------------------------------------------------------------- */
+
+  virtual int constructorHandler(Node *n) {
+    int r = Language::constructorHandler(n);
+    if (r == SWIG_OK && arena_constructors && GetFlag(n, "feature:go:arena") && checkArenaConstructor(n)) {
+      Append(arena_constructors, n);
+    }
+    return r;
+  }
+
+  /* ----------------------------------------------------------------------
+   * checkArenaConstructor()
+   *
+   * Check whether a constructor can allocate its object in an arena,
+   * issuing a warning if not.
+   * ---------------------------------------------------------------------- */
+
+  bool checkArenaConstructor(Node *n) {
+    const char *reason = NULL;
+    if (!Swig_symbol_clookup("SwigGoArena", 0)) {
+      reason = "goarena.i has not been included";
+    } else if (Swig_directorclass(n)) {
+      reason = "director classes can not be allocated in an arena";
+    } else if (GetFlag(n, "feature:extend")) {
+      reason = "%extend constructors can not be allocated in an arena";
+    } else if (GetFlag(class_node, "allocate:private_destructor")) {
+      reason = "the destructor is not public";
+    }
+    if (reason) {
+      Swig_warning(WARN_GO_ARENA_IGNORED, input_file, line_number, "Ignoring goarena feature for '%s', %s\n", Getattr(n, "sym:name"), reason);
+      return false;
+    }
+    return true;
+  }
+
+  /* ----------------------------------------------------------------------
+   * emitArenaConstructors()
+   *
+   * Write out a New<Class>InArena function for each constructor in
+   * arena_constructors.  This takes a SwigArena as an additional
+   * first argument and constructs the object in memory allocated from
+   * the arena, registering the destructor to be run when the arena is
+   * reset or deleted.  The Go code does not own the object.
+   * ---------------------------------------------------------------------- */
+
+  int emitArenaConstructors() {
+    // Constructors renamed with %rename get separate functions.
+    Hash *groups = NewHash();
+    List *order = NewList();
+    for (Iterator i = First(arena_constructors); i.item; i = Next(i)) {
+      String *symname = Getattr(i.item, "sym:name");
+      List *group = Getattr(groups, symname);
+      if (!group) {
+	group = NewList();
+	Setattr(groups, symname, group);
+	Append(order, group);
+	Delete(group);
+      }
+      Append(group, i.item);
+    }
+
+    int ret = SWIG_OK;
+
+    for (Iterator g = First(order); g.item; g = Next(g)) {
+      bool overloaded = Len(g.item) > 1;
+      List *clones = NewList();
+      Node *first = NULL;
+      Node *prev = NULL;
+      for (Iterator i = First(g.item); i.item; i = Next(i)) {
+	Node *an = makeArenaConstructor(i.item);
+	if (overloaded) {
+	  if (!first) {
+	    first = an;
+	  }
+	  Setattr(an, "sym:overloaded", first);
+	  Delattr(an, "sym:nextSibling");
+	  if (prev) {
+	    Setattr(prev, "sym:nextSibling", an);
+	  }
+	  prev = an;
+	} else {
+	  Delattr(an, "sym:overloaded");
+	  Delattr(an, "sym:nextSibling");
+	  Delattr(an, "sym:overname");
+	}
+	Append(clones, an);
+	Delete(an);
+      }
+
+      for (Iterator i = First(clones); i.item; i = Next(i)) {
+	int r = functionWrapper(i.item);
+	if (r != SWIG_OK) {
+	  ret = r;
+	}
+      }
+      Delete(clones);
+    }
+
+    Delete(order);
+    Delete(groups);
+
+    return ret;
+  }
+
+  /* ----------------------------------------------------------------------
+   * makeArenaConstructor()
+   *
+   * Return a copy of the constructor n which allocates in an arena.
+   * ---------------------------------------------------------------------- */
+
+  Node *makeArenaConstructor(Node *n) {
+    Node *an = Copy(n);
+    SwigType *ct = getClassType();
+    String *cname = SwigType_str(ct, 0);
+
+    ParmList *parms = Getattr(n, "parms");
+    if (parms && SwigType_type(Getattr(parms, "type")) == T_VOID && !nextSibling(parms)) {
+      parms = NULL;
+    }
+    Parm *arena = NewParm(NewString("p.SwigGoArena"), "swig_arena", n);
+    Delete(Swig_cparm_name(arena, 0));
+    ParmList *rest = CopyParmList(parms);
+    set_nextSibling(arena, rest);
+    Delete(rest);
+
+    SwigType *type = Copy(ct);
+    SwigType_add_pointer(type);
+
+    String *action = NewString("{\n");
+    if (CPlusPlus) {
+      // Skipping the arena, the constructor arguments start at arg2.
+      String *call = Swig_cppconstructor_nodirector_call(ct, arena);
+      Replace(call, "new ", "::new (swig_mem) ", DOH_REPLACE_FIRST);
+      String *cres = Swig_cresult(type, Swig_cresult_name(), call);
+      Printv(action, "swig_go_arena_cleanup *swig_cleanup;\n", NULL);
+      Printf(action, "void *swig_mem = SWIG_GoArena_AllocateObject(arg1, sizeof(%s), &swig_cleanup);\n", cname);
+      Printv(action, cres, "\n", NULL);
+      Printf(action, "SWIG_GoArena_AddCleanup(arg1, swig_cleanup, %s, SWIG_GoArena_Destroy< %s >);\n", Swig_cresult_name(), cname);
+      Delete(cres);
+      Delete(call);
+    } else {
+      String *call = NewStringf("SWIG_GoArena_Allocate(arg1, sizeof(%s))", cname);
+      String *cres = Swig_cresult(type, Swig_cresult_name(), call);
+      Printv(action, cres, "\n", NULL);
+      Printf(action, "if (%s) memset(%s, 0, sizeof(%s));\n", Swig_cresult_name(), Swig_cresult_name(), cname);
+      Delete(cres);
+      Delete(call);
+    }
+    Printv(action, "}", NULL);
+
+    String *symname = NewStringf("%sInArena", Getattr(n, "sym:name"));
+    String *mrename = Swig_name_construct(getNSpace(), symname);
+
+    Setattr(an, "sym:name", mrename);
+    Setattr(an, "parms", arena);
+    Setattr(an, "type", type);
+    Setattr(an, "wrap:action", action);
+    // The arena owns the object.
+    Delattr(an, "feature:new");
+    Delattr(an, "feature:go:batch");
+
+    Delete(mrename);
+    Delete(symname);
+    Delete(action);
+    Delete(type);
+    Delete(arena);
+    Delete(cname);
+
+    return an;
+  }
+
   /* ----------------------------------------------------------------------
    * makeWrappers()
    *
@@ -1033,6 +1215,10 @@ private:
 	ret = r;
       }
     } else {
+      if (GetFlag(n, "feature:go:batch") && !base) {
+	Swig_warning(WARN_GO_BATCH_IGNORED, input_file, line_number, "Ignoring gobatch feature for '%s', batching requires -cgo\n", Getattr(n, "sym:name"));
+      }
+
       int r = goFunctionWrapper(n, name, go_name, overname, wname, base, parms, result, is_static);
       if (r != SWIG_OK) {
 	ret = r;
@@ -1145,6 +1331,13 @@ private:
       ret = r;
     }
 
+    if (GetFlag(n, "feature:go:batch") && !base) {
+      r = cgoBatchWrapper(&info);
+      if (r != SWIG_OK) {
+	ret = r;
+      }
+    }
+
     Swig_restore(n);
 
     return ret;
@@ -1618,6 +1811,220 @@ private:
     return SWIG_OK;
   }
 
+  /* ----------------------------------------------------------------------
+   * cgoBatchWrapper()
+   *
+   * Write out a batch type for a function with the gobatch feature.
+   * Calls are queued in Go slices of C values and all of them are run
+   * with a single cgo call to a C function which loops over the
+   * queued arguments calling the C wrapper written by cgoGccWrapper.
+   * Only functions whose arguments and result are passed as simple C
+   * values can be batched, as the slices are passed to C directly and
+   * so must not contain Go pointers.
+   * ---------------------------------------------------------------------- */
+  int cgoBatchWrapper(const cgoWrapperInfo *info) {
+    int parm_count = emit_num_arguments(info->parms);
+    int required_count = emit_num_required(info->parms);
+    bool is_void = SwigType_type(info->result) == T_VOID;
+
+    String *symname = Getattr(info->n, "sym:name");
+
+    if (info->is_constructor || info->is_destructor || parm_count > required_count) {
+      Swig_warning(WARN_GO_BATCH_IGNORED, input_file, line_number, "Ignoring gobatch feature for '%s', only functions without default arguments can be batched\n", symname);
+      return SWIG_OK;
+    }
+
+    bool c_struct_type;
+    Parm *p = info->parms;
+    for (int i = 0; i < parm_count; ++i) {
+      p = getParm(p);
+      SwigType *pt = Getattr(p, "type");
+      Delete(cgoTypeForGoValue(p, pt, &c_struct_type));
+      if (c_struct_type || goGetattr(p, "tmap:goin") || goGetattr(p, "tmap:goargout")) {
+	Swig_warning(WARN_GO_BATCH_IGNORED, input_file, line_number, "Ignoring gobatch feature for '%s', the parameter type %s can not be batched\n", symname, SwigType_str(pt, 0));
+	return SWIG_OK;
+      }
+      p = nextParm(p);
+    }
+
+    if (!is_void) {
+      Delete(cgoTypeForGoValue(info->n, info->result, &c_struct_type));
+      Swig_save("cgoBatchWrapper", info->n, "type", "tmap:goout", NULL);
+      Setattr(info->n, "type", info->result);
+      String *goout = goTypemapLookup("goout", info->n, "swig_r");
+      Swig_restore(info->n);
+      if (c_struct_type || goout) {
+	Swig_warning(WARN_GO_BATCH_IGNORED, input_file, line_number, "Ignoring gobatch feature for '%s', the return type %s can not be batched\n", symname, SwigType_str(info->result, 0));
+	return SWIG_OK;
+      }
+    }
+
+    String *batch_name = NewString("");
+    String *called_name = NewString("");
+    if (info->receiver) {
+      String *cl = exportedName(class_name);
+      Append(batch_name, cl);
+      Printv(called_name, cl, ".", NULL);
+      Delete(cl);
+    }
+    Printv(batch_name, info->go_name, NULL);
+    Printv(called_name, info->go_name, NULL);
+    if (info->overname) {
+      Printv(batch_name, info->overname, NULL);
+    }
+    Printv(batch_name, "Batch", NULL);
+
+    if (!checkNameConflict(batch_name, info->n, NULL)) {
+      Delete(called_name);
+      Delete(batch_name);
+      return SWIG_OK;
+    }
+
+    String *batch_wname = NewStringf("%s_batch", info->wname);
+
+    // The Go batch type.
+
+    String *go_parms = NewString("");
+    String *go_append = NewString("");
+    String *go_reset = NewString("");
+    String *go_call = NewString("");
+    String *cgo_parms = NewString("");
+    String *c_parms = NewString("");
+    String *c_call = NewString("");
+
+    Printv(f_go_wrappers, "// ", batch_name, " queues calls to ", called_name, " so that they run in a single cgo call.\n", NULL);
+    Printv(f_go_wrappers, "type ", batch_name, " struct {\n", NULL);
+    Printv(f_go_wrappers, "\tswig_n int\n", NULL);
+
+    p = info->parms;
+    for (int i = 0; i < parm_count; ++i) {
+      p = getParm(p);
+      SwigType *pt = Copy(Getattr(p, "type"));
+      String *ln = Getattr(p, "lname");
+
+      String *ct = cgoTypeForGoValue(p, pt, &c_struct_type);
+      Printf(f_go_wrappers, "\tswig_a%d []C.%s\n", i, ct);
+
+      String *tm = goType(p, pt);
+      Printv(go_parms, i > 0 ? ", " : "", ln, " ", tm, NULL);
+      Delete(tm);
+
+      Printf(go_append, "\tswig_b.swig_a%d = append(swig_b.swig_a%d, C.%s(%s", i, i, ct, ln);
+      if (goTypeIsInterface(p, pt)) {
+	Printv(go_append, ".Swigcptr()", NULL);
+      }
+      Printv(go_append, "))\n", NULL);
+
+      Printf(go_reset, "\tswig_b.swig_a%d = swig_b.swig_a%d[:0]\n", i, i);
+      Printf(go_call, ", &swig_b.swig_a%d[0]", i);
+
+      Printf(cgo_parms, ", %s *%s", ct, ln);
+
+      if (SwigType_isarray(pt)) {
+	SwigType_del_array(pt);
+	SwigType_add_pointer(pt);
+      }
+      String *pn = NewStringf("*_swig_go_%d", i);
+      String *gct = gcCTypeForGoValue(p, pt, pn);
+      Printv(c_parms, ", ", gct, NULL);
+      Printf(c_call, "%s_swig_go_%d[_swig_i]", i > 0 ? ", " : "", i);
+      Delete(gct);
+      Delete(pn);
+
+      Delete(ct);
+      Delete(pt);
+      p = nextParm(p);
+    }
+
+    String *ret_ct = NULL;
+    if (!is_void) {
+      ret_ct = cgoTypeForGoValue(info->n, info->result, &c_struct_type);
+      Printf(f_go_wrappers, "\tswig_r []C.%s\n", ret_ct);
+      Printv(go_call, ", &swig_b.swig_r[0]", NULL);
+      Printf(cgo_parms, ", %s *_swig_result", ret_ct);
+      String *rn = NewString("*_swig_go_result");
+      String *gct = gcCTypeForGoValue(info->n, info->result, rn);
+      Printv(c_parms, ", ", gct, NULL);
+      Delete(gct);
+      Delete(rn);
+    }
+
+    Printv(f_go_wrappers, "}\n\n", NULL);
+
+    Printv(f_go_wrappers, "// Add queues a call to ", called_name, ".\n", NULL);
+    Printv(f_go_wrappers, "func (swig_b *", batch_name, ") Add(", go_parms, ") {\n", NULL);
+    Printv(f_go_wrappers, go_append, NULL);
+    Printv(f_go_wrappers, "\tswig_b.swig_n++\n", NULL);
+    Printv(f_go_wrappers, "}\n\n", NULL);
+
+    Printv(f_go_wrappers, "// Len returns the number of queued calls.\n", NULL);
+    Printv(f_go_wrappers, "func (swig_b *", batch_name, ") Len() int {\n", NULL);
+    Printv(f_go_wrappers, "\treturn swig_b.swig_n\n", NULL);
+    Printv(f_go_wrappers, "}\n\n", NULL);
+
+    Printv(f_go_wrappers, "// Run makes all the queued calls with a single cgo call and clears the queue.\n", NULL);
+    Printv(f_go_wrappers, "func (swig_b *", batch_name, ") Run() {\n", NULL);
+    Printv(f_go_wrappers, "\tswig_n := swig_b.swig_n\n", NULL);
+    Printv(f_go_wrappers, "\tif swig_n == 0 {\n", "\t\treturn\n", "\t}\n", NULL);
+    if (!is_void) {
+      Printv(f_go_wrappers, "\tif cap(swig_b.swig_r) < swig_n {\n", NULL);
+      Printf(f_go_wrappers, "\t\tswig_b.swig_r = make([]C.%s, swig_n)\n", ret_ct);
+      Printv(f_go_wrappers, "\t}\n", NULL);
+      Printv(f_go_wrappers, "\tswig_b.swig_r = swig_b.swig_r[:swig_n]\n", NULL);
+    }
+    Printv(f_go_wrappers, "\tC.", batch_wname, "(C.swig_intgo(swig_n)", go_call, ")\n", NULL);
+    Printv(f_go_wrappers, "\tswig_b.Reset()\n", NULL);
+    Printv(f_go_wrappers, "}\n\n", NULL);
+
+    if (!is_void) {
+      String *tm = goType(info->n, info->result);
+      Printv(f_go_wrappers, "// Result returns the result of call i of the last Run.\n", NULL);
+      Printv(f_go_wrappers, "func (swig_b *", batch_name, ") Result(i int) ", tm, " {\n", NULL);
+      if (goTypeIsInterface(info->n, info->result)) {
+	String *wt = goWrapperType(info->n, info->result, true);
+	Printv(f_go_wrappers, "\treturn ", wt, "(swig_b.swig_r[i])\n", NULL);
+	Delete(wt);
+      } else {
+	Printv(f_go_wrappers, "\treturn ", tm, "(swig_b.swig_r[i])\n", NULL);
+      }
+      Printv(f_go_wrappers, "}\n\n", NULL);
+      Delete(tm);
+    }
+
+    Printv(f_go_wrappers, "// Reset clears the queued calls, keeping the allocated memory.\n", NULL);
+    Printv(f_go_wrappers, "func (swig_b *", batch_name, ") Reset() {\n", NULL);
+    Printv(f_go_wrappers, "\tswig_b.swig_n = 0\n", NULL);
+    Printv(f_go_wrappers, go_reset, NULL);
+    Printv(f_go_wrappers, "}\n\n", NULL);
+
+    // The declaration in the cgo comment.
+
+    Printv(f_cgo_comment, "extern void ", batch_wname, "(intgo _swig_n", cgo_parms, ");\n", NULL);
+
+    // The C function which makes the calls.
+
+    Printv(f_c_wrappers, "void ", batch_wname, "(intgo _swig_n", c_parms, ") {\n", NULL);
+    Printv(f_c_wrappers, "\tintgo _swig_i;\n", NULL);
+    Printv(f_c_wrappers, "\tfor (_swig_i = 0; _swig_i < _swig_n; ++_swig_i) {\n", NULL);
+    Printv(f_c_wrappers, "\t\t", is_void ? "" : "_swig_go_result[_swig_i] = ", info->wname, "(", c_call, ");\n", NULL);
+    Printv(f_c_wrappers, "\t}\n", NULL);
+    Printv(f_c_wrappers, "}\n\n", NULL);
+
+    Delete(ret_ct);
+    Delete(c_call);
+    Delete(c_parms);
+    Delete(cgo_parms);
+    Delete(go_call);
+    Delete(go_reset);
+    Delete(go_append);
+    Delete(go_parms);
+    Delete(batch_wname);
+    Delete(called_name);
+    Delete(batch_name);
+
+    return SWIG_OK;
+  }
+
   /* ----------------------------------------------------------------------
    * goFunctionWrapper()
    *
@@ -2974,8 +3381,14 @@ private:
     Setattr(defined_types, go_type_name, go_type_name);
 
     interfaces = NewString("");
+    arena_constructors = NewList();
 
     int r = Language::classHandler(n);
+    if (r == SWIG_OK && Len(arena_constructors) > 0) {
+      r = emitArenaConstructors();
+    }
+    Delete(arena_constructors);
+    arena_constructors = NULL;
     if (r != SWIG_OK) {
       return r;
     }
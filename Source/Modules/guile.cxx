@@ -23,6 +23,8 @@ Guile Options (available with -guile)\n\
      -emitslotaccessors      - Emit accessor methods for all GOOPS slots\n" "\
      -exportprimitive        - Add the (export ...) code from scmstub into the\n\
                                GOOPS file.\n\
+     -foreignobjects         - Represent pointers as foreign objects rather than\n\
+                               smobs (requires Guile >= 2.2)\n\
      -goopsprefix <prefix>   - Prepend <prefix> to all goops identifiers\n\
      -Linkage <lstyle>       - Use linkage protocol <lstyle> (default `simple')\n\
                                Use `module' for native Guile module linking\n\
@@ -68,6 +70,7 @@ static enum {
 
 static File *procdoc = 0;
 static bool scmstub = false;
+static bool foreign_objects = false;
 static String *scmtext;
 static bool goops = false;
 static String *goopstext;
@@ -209,6 +212,9 @@ public:
 	} else if (strcmp(argv[i], "-scmstub") == 0) {
 	  scmstub = true;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-foreignobjects") == 0) {
+	  foreign_objects = true;
+	  Swig_mark_arg(i);
 	} else if ((strcmp(argv[i], "-shadow") == 0) || ((strcmp(argv[i], "-proxy") == 0))) {
 	  goops = true;
 	  Swig_mark_arg(i);
@@ -324,6 +330,9 @@ public:
 
     Printf(f_runtime, "\n\n#ifndef SWIGGUILE\n#define SWIGGUILE\n#endif\n\n");
 
+    if (foreign_objects)
+      Printf(f_runtime, "#define SWIG_GUILE_FOREIGN_OBJECTS\n\n");
+
     /* Write out directives and declarations */
 
     module = Swig_copy_string(Char(Getattr(n, "name")));
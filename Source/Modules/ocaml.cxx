@@ -785,6 +785,9 @@ public:
     if ((!classmode || in_constructor || in_destructor || static_member_function) && expose_func)
       Printf(f_mlibody, "val %s : c_obj -> c_obj\n", mangled_name);
 
+    if (expose_func && (GetFlag(n, "feature:ocaml:direct") || GetFlag(n, "feature:ocaml:noalloc")))
+      directExternal(n, mangled_name);
+
     Delete(proc_name);
     Delete(target);
     Delete(arg);
@@ -795,6 +798,162 @@ public:
     return SWIG_OK;
   }
 
+  /* ------------------------------------------------------------
+   * directExternal()
+   *
+   * Emit an additional external declaration, <name>_direct, for a function
+   * with the ocaml:direct feature.  It takes and returns OCaml values of the
+   * types given by the mltype typemaps instead of c_obj lists, so floats and
+   * ints are passed unboxed and untagged to the native code stub.  The
+   * ctype attribute of the mltype typemaps gives the C type of the native
+   * stub arguments and result, one of double, intnat or CAML_VALUE; the
+   * bytecode stub converts between these and values.
+   * ------------------------------------------------------------ */
+
+  void directExternal(Node *n, String *mangled_name) {
+    ParmList *l = Getattr(n, "parms");
+    SwigType *type = Getattr(n, "type");
+    String *reason = 0;
+
+    if (Getattr(n, "sym:overloaded")) {
+      reason = NewString("it is overloaded");
+    } else if (classmode && !static_member_function) {
+      reason = NewString("it is not a global function or static member function");
+    } else if (emit_isvarargs(l)) {
+      reason = NewString("it takes a variable number of arguments");
+    }
+
+    Wrapper *f = NewWrapper();
+    String *wname = NewStringf("%s_direct", Getattr(n, "wrap:name"));
+    String *bytename = NewStringf("%s_direct_byte", Getattr(n, "wrap:name"));
+    String *mltype = NewString("");
+    String *nativeparms = NewString("");
+    String *byteargs = NewString("");
+    List *ctypes = NewList();
+    bool noalloc = GetFlag(n, "feature:ocaml:noalloc") ? true : false;
+    int numargs = 0;
+
+    if (!reason) {
+      emit_parameter_variables(l, f);
+      Swig_typemap_attach_parms("mltype", l, f);
+      Swig_typemap_attach_parms("directin", l, f);
+
+      for (Parm *p = l; p; numargs++) {
+	String *tm = Getattr(p, "tmap:mltype");
+	String *in = Getattr(p, "tmap:directin");
+	if (!tm || !in) {
+	  reason = NewStringf("no mltype or directin typemap is defined for %s", SwigType_str(Getattr(p, "type"), 0));
+	  break;
+	}
+	String *ctype = Getattr(p, "tmap:mltype:ctype");
+	String *input = NewStringf("swig_arg%d", numargs);
+	Printf(mltype, "%s -> ", tm);
+	Printf(nativeparms, "%s%s %s", numargs ? ", " : "", ctype ? ctype : "CAML_VALUE", input);
+	Append(ctypes, ctype ? ctype : "CAML_VALUE");
+	if (GetFlag(p, "tmap:mltype:alloc"))
+	  noalloc = false;
+	tm = Copy(in);
+	Replaceall(tm, "$input", input);
+	Printv(f->code, tm, "\n", NIL);
+	Delete(tm);
+	Delete(input);
+	p = Getattr(p, "tmap:mltype:next");
+      }
+    }
+
+    String *rtype = 0;
+    String *out = 0;
+    if (!reason) {
+      rtype = Swig_typemap_lookup("mltype", n, Swig_cresult_name(), 0);
+      out = Swig_typemap_lookup("directout", n, Swig_cresult_name(), 0);
+      if (!rtype || !out)
+	reason = NewStringf("no mltype or directout typemap is defined for %s", SwigType_str(type, 0));
+    }
+
+    if (reason) {
+      String *decl = Swig_name_decl(n);
+      Swig_warning(WARN_OCAML_DIRECT_IGNORED, input_file, line_number, "Direct external ignored for %s as %s.\n", decl, reason);
+      Delete(decl);
+      Delete(reason);
+    } else {
+      String *rctype = Getattr(n, "tmap:mltype:ctype");
+      if (!rctype)
+	rctype = NewString("CAML_VALUE");
+      if (GetFlag(n, "tmap:mltype:alloc"))
+	noalloc = false;
+      if (noalloc && (Getattr(n, "catchlist") || Getattr(n, "feature:except") || Getattr(n, "throws"))) {
+	String *decl = Swig_name_decl(n);
+	Swig_warning(WARN_OCAML_DIRECT_IGNORED, input_file, line_number, "The noalloc attribute is ignored for %s as it handles exceptions.\n", decl);
+	Delete(decl);
+	noalloc = false;
+      }
+
+      if (numargs == 0) {
+	/* The external still takes a unit argument. */
+	Printf(mltype, "unit -> ");
+	Printf(nativeparms, "CAML_VALUE swig_unit");
+      }
+      Printf(mltype, "%s", rtype);
+
+      // The native code stub
+      Printv(f->def, "SWIGEXT ", rctype, " ", wname, "(", nativeparms, ") {", NIL);
+      Wrapper_add_localv(f, "swig_result", rctype, "swig_result", NIL);
+      emit_return_variable(n, type, f);
+      Printv(f->code, emit_action(n), NIL);
+      Replaceall(out, "$result", "swig_result");
+      Printv(f->code, out, "\n", NIL);
+      Printv(f->code, "return swig_result;\n", "}\n", NIL);
+      Replaceall(f->code, "$symname", Getattr(n, "sym:name"));
+      Wrapper_print(f, f_wrappers);
+
+      // The bytecode stub, which takes an array of arguments beyond five
+      String *byteparms = NewString("");
+      if (numargs > 5)
+	Printf(byteparms, "CAML_VALUE *argv, int argn");
+      for (int i = 0; i < numargs; i++) {
+	String *ctype = Getitem(ctypes, i);
+	String *arg = numargs > 5 ? NewStringf("argv[%d]", i) : NewStringf("swig_arg%d", i);
+	if (numargs <= 5)
+	  Printf(byteparms, "%sCAML_VALUE %s", i ? ", " : "", arg);
+	if (Equal(ctype, "double"))
+	  Printf(byteargs, "%sDouble_val(%s)", i ? ", " : "", arg);
+	else if (Equal(ctype, "intnat"))
+	  Printf(byteargs, "%sLong_val(%s)", i ? ", " : "", arg);
+	else
+	  Printf(byteargs, "%s%s", i ? ", " : "", arg);
+	Delete(arg);
+      }
+      if (numargs == 0) {
+	Printf(byteparms, "CAML_VALUE swig_unit");
+	Printf(byteargs, "swig_unit");
+      }
+      String *call = NewStringf("%s(%s)", wname, byteargs);
+      Printf(f_wrappers, "SWIGEXT CAML_VALUE %s(%s) {\n", bytename, byteparms);
+      if (Equal(rctype, "double"))
+	Printf(f_wrappers, "  return caml_copy_double(%s);\n", call);
+      else if (Equal(rctype, "intnat"))
+	Printf(f_wrappers, "  return Val_long(%s);\n", call);
+      else
+	Printf(f_wrappers, "  return %s;\n", call);
+      Printf(f_wrappers, "}\n\n");
+
+      String *ext = NewStringf("external %s_direct : %s = \"%s\" \"%s\"%s", mangled_name, mltype, bytename, wname, noalloc ? " [@@noalloc]" : "");
+      Printv(f_mlbody, ext, " ;;\n", NIL);
+      Printv(f_mlibody, ext, "\n", NIL);
+      Delete(ext);
+      Delete(call);
+      Delete(byteparms);
+    }
+
+    Delete(ctypes);
+    Delete(byteargs);
+    Delete(nativeparms);
+    Delete(mltype);
+    Delete(bytename);
+    Delete(wname);
+    DelWrapper(f);
+  }
+
   /* ------------------------------------------------------------
    * variableWrapper()
    *
@@ -1045,7 +1045,7 @@ public:
       Delete(cname);
     } else
       Printv(f_wrappers, "0", ",", NIL);
-    Printf(f_wrappers, "swig_%s_members,swig_%s_base_names,swig_%s_base };\n\n", class_name, class_name, class_name);
+    Printf(f_wrappers, "swig_%s_members,swig_%s_base_names,swig_%s_base,0,0 };\n\n", class_name, class_name, class_name);
 
     Delete(base_class);
     Delete(base_class_names);
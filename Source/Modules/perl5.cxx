@@ -19,6 +19,7 @@ static const char *usage = "\
 Perl 5 Options (available with -perl5)\n\
      -compat         - Compatibility mode\n\
      -const          - Wrap constants as constants and not variables (implies -proxy)\n\
+     -fastproxy      - Represent proxy objects as blessed scalar references rather than tied hashes (implies -proxy)\n\
      -nopm           - Do not generate the .pm file\n\
      -noproxy        - Don't create proxy classes\n\
      -proxy          - Create proxy classes\n\
@@ -93,6 +94,7 @@ static int          verbose = 0;
 /* The following variables are used to manage Perl5 classes */
 
 static int blessed = 1;		/* Enable object oriented features */
+static int fast_proxy = 0;	/* Proxy objects are blessed scalar references */
 static int do_constants = 0;	/* Constant wrapping */
 static List *classlist = 0;	/* List of classes */
 static int have_constructor = 0;
@@ -171,6 +173,10 @@ public:
 	} else if ((strcmp(argv[i], "-noproxy") == 0)) {
 	  blessed = 0;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-fastproxy") == 0) {
+	  blessed = 1;
+	  fast_proxy = 1;
+	  Swig_mark_arg(i);
 	} else if (strcmp(argv[i], "-const") == 0) {
 	  do_constants = 1;
 	  blessed = 1;
@@ -251,6 +257,10 @@ public:
 	      Printv(stderr, "*** directors are not supported with -noproxy\n", NIL);
 	      allow = 0;
 	    }
+	    if (fast_proxy) {
+	      Printv(stderr, "*** directors are not supported with -fastproxy\n", NIL);
+	      allow = 0;
+	    }
 	    if (no_pmfile) {
 	      Printv(stderr, "*** directors are not supported with -nopm\n", NIL);
 	      allow = 0;
@@ -325,6 +335,9 @@ public:
       Printf(f_runtime, "#define SWIG_DIRECTORS\n");
     }
     Printf(f_runtime, "#define SWIG_CASTRANK_MODE\n");
+    if (fast_proxy) {
+      Printf(f_runtime, "#define SWIG_PERL_FASTPROXY\n");
+    }
     Printf(f_runtime, "\n");
 
     // Is the imported module in another package?  (IOW, does it use the
@@ -440,6 +453,9 @@ public:
 	Printf(f_pm,"use base qw(DynaLoader);\n");
       }
     }
+    if (fast_proxy) {
+      Printf(f_pm,"use Scalar::Util ();\n");
+    }
 
     /* Start creating magic code */
 
@@ -579,7 +595,11 @@ public:
 
 	/* Output a 'this' method */
 
-	Printv(base, "sub this {\n", tab4, "my $ptr = shift;\n", tab4, "return tied(%$ptr);\n", "}\n\n", NIL);
+	if (fast_proxy) {
+	  Printv(base, "sub this {\n", tab4, "return shift;\n", "}\n\n", NIL);
+	} else {
+	  Printv(base, "sub this {\n", tab4, "my $ptr = shift;\n", tab4, "return tied(%$ptr);\n", "}\n\n", NIL);
+	}
 
 	Printf(f_pm, "%s", base);
       }
@@ -1467,13 +1487,23 @@ public:
       } else {
 	director_disown = NewString("");
       }
-      Printv(pm,
-	     "sub DISOWN {\n",
-	     tab4, "my $self = shift;\n",
-	     director_disown,
-	     tab4, "my $ptr = tied(%$self);\n",
-	     tab4, "delete $OWNER{$ptr};\n",
-	     "}\n\n", "sub ACQUIRE {\n", tab4, "my $self = shift;\n", tab4, "my $ptr = tied(%$self);\n", tab4, "$OWNER{$ptr} = 1;\n", "}\n\n", NIL);
+      if (fast_proxy) {
+	/* Ownership is keyed on the address of the referenced scalar so that it survives reblessing */
+	Printv(pm,
+	       "sub DISOWN {\n",
+	       tab4, "my $self = shift;\n",
+	       director_disown,
+	       tab4, "delete $OWNER{Scalar::Util::refaddr($self)};\n",
+	       "}\n\n", "sub ACQUIRE {\n", tab4, "my $self = shift;\n", tab4, "$OWNER{Scalar::Util::refaddr($self)} = 1;\n", "}\n\n", NIL);
+      } else {
+	Printv(pm,
+	       "sub DISOWN {\n",
+	       tab4, "my $self = shift;\n",
+	       director_disown,
+	       tab4, "my $ptr = tied(%$self);\n",
+	       tab4, "delete $OWNER{$ptr};\n",
+	       "}\n\n", "sub ACQUIRE {\n", tab4, "my $self = shift;\n", tab4, "my $ptr = tied(%$self);\n", tab4, "$OWNER{$ptr} = 1;\n", "}\n\n", NIL);
+      }
       Delete(director_disown);
 
       /* Only output the following methods if a class has member data */
@@ -1745,6 +1775,16 @@ public:
 	Replaceall(plcode, "$action", plaction);
 	Delete(plaction);
 	Printv(pcode, plcode, NIL);
+      } else if (fast_proxy) {
+	Printv(pcode,
+	       "sub DESTROY {\n",
+	       tab4, "my $self = Scalar::Util::refaddr($_[0]);\n",
+	       tab4, "return unless defined $self;\n",
+	       tab4, "delete $ITERATORS{$self};\n",
+	       tab4, "if (exists $OWNER{$self}) {\n",
+	       tab8, "my $ptr = ref($_[0]) eq __PACKAGE__ ? $_[0] : bless \\(my $p = ${$_[0]}), __PACKAGE__;\n",
+	       tab8, cmodule, "::", Swig_name_destroy(NSPACE_TODO, symname), "($ptr);\n", tab8, "delete $OWNER{$self};\n", tab4, "}\n}\n\n", NIL);
+	have_destructor = 1;
       } else {
 	Printv(pcode,
 	       "sub DESTROY {\n",
@@ -45,6 +45,7 @@
 static const char *usage = "\
 PHP 7 Options (available with -php7)\n\
      -noproxy         - Don't generate proxy classes.\n\
+     -objecthandles   - Hold pointers in SWIG\\Handle objects rather than resources\n\
      -prefix <prefix> - Prepend <prefix> to all class names in PHP wrappers\n\
 \n";
 
@@ -114,6 +115,7 @@ static Hash *shadow_set_vars;
 static Hash *zend_types = 0;
 
 static int shadow = 1;
+static int object_handles = 0;
 
 static bool class_has_ctor = false;
 static String *wrapping_member_constant = NULL;
@@ -133,38 +135,70 @@ extern "C" {
   static void (*r_prevtracefunc) (const SwigType *t, String *mangled, String *clientdata) = 0;
 }
 
+/* PHP code to test whether $var holds a pointer, and to get the mangled type
+ * name of that pointer.  With -objecthandles pointers are SWIG\Handle objects
+ * rather than resources.
+ */
+static String *SwigPHP_is_pointer(const char *var) {
+  if (object_handles)
+    return NewStringf("$%s instanceof \\SWIG\\Handle", var);
+  return NewStringf("is_resource($%s)", var);
+}
+
+static String *SwigPHP_pointer_type(const char *var) {
+  if (object_handles)
+    return NewStringf("$%s->getType()", var);
+  return NewStringf("get_resource_type($%s)", var);
+}
+
 static void SwigPHP_emit_resource_registrations() {
   Iterator ki;
   bool emitted_default_dtor = false;
 
+  if (object_handles)
+    Printf(s_oinit, "  SWIG_Php_RegisterHandleClass();\n");
+
   if (!zend_types)
     return;
 
   ki = First(zend_types);
   if (ki.key)
-    Printf(s_oinit, "\n  /* Register resource destructors for pointer types */\n");
+    Printf(s_oinit, "\n  /* Register %s for pointer types */\n", object_handles ? "destructors" : "resource destructors");
   while (ki.key) {
     DOH *key = ki.key;
     Node *class_node = ki.item;
     String *human_name = key;
     String *rsrc_dtor_name = NULL;
+    String *destructor = NULL;
 
     // write out body
     if (class_node != NOTCLASS) {
-      String *destructor = Getattr(class_node, "destructor");
+      destructor = Getattr(class_node, "destructor");
       human_name = Getattr(class_node, "sym:name");
       if (!human_name)
         human_name = Getattr(class_node, "name");
       // Do we have a known destructor for this type?
-      if (destructor) {
+      if (destructor && !object_handles) {
 	rsrc_dtor_name = NewStringf("_wrap_destroy%s", key);
 	// Write out custom destructor function
 	Printf(s_wrappers, "static ZEND_RSRC_DTOR_FUNC(%s) {\n", rsrc_dtor_name);
-        Printf(s_wrappers, "  %s(res, SWIGTYPE%s->name);\n", destructor, key);
+	Printf(s_wrappers, "  swig_object_wrapper *value=(swig_object_wrapper *) res->ptr;\n");
+	Printf(s_wrappers, "  void *ptr=value->ptr;\n");
+	Printf(s_wrappers, "  int newobject=value->newobject;\n");
+	Printf(s_wrappers, "  efree(value);\n");
+	Printf(s_wrappers, "  %s(ptr, newobject, SWIGTYPE%s->name);\n", destructor, key);
 	Printf(s_wrappers, "}\n");
       }
     }
 
+    if (object_handles) {
+      // The destructor is called from the free_obj handler of SWIG\Handle.
+      Printf(s_wrappers, "static swig_php_type_data swig_php_type%s={%s}; /* %s */\n", key, destructor ? Char(destructor) : "NULL", human_name);
+      Printf(s_oinit, "  SWIG_TypeClientData(SWIGTYPE%s,&swig_php_type%s);\n", key, key);
+      ki = Next(ki);
+      continue;
+    }
+
     if (!rsrc_dtor_name) {
       rsrc_dtor_name = NewString("_swig_default_rsrc_destroy");
       if (!emitted_default_dtor) {
@@ -218,6 +252,9 @@ public:
       } else if ((strcmp(argv[i], "-noshadow") == 0) || (strcmp(argv[i], "-noproxy") == 0)) {
 	shadow = 0;
 	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-objecthandles") == 0) {
+	object_handles = 1;
+	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-help") == 0) {
 	fputs(usage, stdout);
       }
@@ -307,6 +344,10 @@ public:
       Printf(f_runtime, "#define SWIG_DIRECTORS\n");
     }
 
+    if (object_handles) {
+      Printf(f_runtime, "#define SWIG_PHP_OBJECT_HANDLES\n");
+    }
+
     /* Set the module name */
     module = Copy(Getattr(n, "name"));
     cap_module = NewStringf("%(upper)s", module);
@@ -409,7 +450,8 @@ public:
     Append(s_header, "    WRONG_PARAM_COUNT;\n");
     Append(s_header, "  }\n");
     Append(s_header, "\n");
-    Append(s_header, "  value = (swig_object_wrapper *) Z_RES_VAL(args[0]);\n");
+    Append(s_header, "  value = SWIG_Php_GetWrapper(&args[0]);\n");
+    Append(s_header, "  if (!value) RETURN_NULL();\n");
     Append(s_header, "  value->newobject = zval_is_true(&args[1]);\n");
     Append(s_header, "\n");
     Append(s_header, "  return;\n");
@@ -423,7 +465,8 @@ public:
     Append(s_header, "    WRONG_PARAM_COUNT;\n");
     Append(s_header, "  }\n");
     Append(s_header, "\n");
-    Append(s_header, "  value = (swig_object_wrapper *) Z_RES_VAL(args[0]);\n");
+    Append(s_header, "  value = SWIG_Php_GetWrapper(&args[0]);\n");
+    Append(s_header, "  if (!value) RETURN_NULL();\n");
     Append(s_header, "  RETVAL_LONG(value->newobject);\n");
     Append(s_header, "\n");
     Append(s_header, "  return;\n");
@@ -1689,7 +1732,11 @@ public:
 	  if (php_constructor) {
 	    // The PHP constructor needs to be able to wrap a resource, but a
 	    // renamed constructor doesn't.
-	    Printf(output, "\t\tif (is_resource($%s) && get_resource_type($%s) === '%s') {\n", arg0, arg0, mangled_type);
+	    String *is_pointer = SwigPHP_is_pointer(arg0);
+	    String *pointer_type = SwigPHP_pointer_type(arg0);
+	    Printf(output, "\t\tif (%s && %s === '%s') {\n", is_pointer, pointer_type, mangled_type);
+	    Delete(pointer_type);
+	    Delete(is_pointer);
 	    Printf(output, "\t\t\t$this->%s=$%s;\n", SWIG_PTR, arg0);
 	    Printf(output, "\t\t\treturn;\n");
 	    Printf(output, "\t\t}\n");
@@ -1765,17 +1812,21 @@ public:
 	    is_abstract = 1;
 	  }
 	  if (newobject || !is_abstract) {
-	    Printf(output, "\t\tif (is_resource($r)) {\n");
+	    String *is_pointer = SwigPHP_is_pointer("r");
+	    Printf(output, "\t\tif (%s) {\n", is_pointer);
+	    Delete(is_pointer);
 	    if (Getattr(classLookup(Getattr(n, "type")), "module")) {
 	      /*
 	       * _p_Foo -> Foo, _p_ns__Bar -> Bar
 	       * TODO: do this in a more elegant way
 	       */
+	      String *pointer_type = SwigPHP_pointer_type("r");
 	      if (Len(prefix) == 0) {
-		Printf(output, "\t\t\t$c=substr(get_resource_type($r), (strpos(get_resource_type($r), '__') ? strpos(get_resource_type($r), '__') + 2 : 3));\n");
+		Printf(output, "\t\t\t$c=substr(%s, (strpos(%s, '__') ? strpos(%s, '__') + 2 : 3));\n", pointer_type, pointer_type, pointer_type);
 	      } else {
-		Printf(output, "\t\t\t$c='%s'.substr(get_resource_type($r), (strpos(get_resource_type($r), '__') ? strpos(get_resource_type($r), '__') + 2 : 3));\n", prefix);
+		Printf(output, "\t\t\t$c='%s'.substr(%s, (strpos(%s, '__') ? strpos(%s, '__') + 2 : 3));\n", prefix, pointer_type, pointer_type, pointer_type);
 	      }
+	      Delete(pointer_type);
 	      Printf(output, "\t\t\tif (class_exists($c)) return new $c($r);\n");
 	      Printf(output, "\t\t\treturn new %s%s($r);\n", prefix, Getattr(classLookup(d), "sym:name"));
 	    } else {
@@ -1789,7 +1840,9 @@ public:
 	    Printf(output, "\t\treturn $this;\n");
 	  }
 	} else {
-	  Printf(output, "\t\tif (!is_resource($r)) return $r;\n");
+	  String *is_pointer = SwigPHP_is_pointer("r");
+	  Printf(output, "\t\tif (!%s) return $r;\n", is_pointer);
+	  Delete(is_pointer);
 	  String *wrapobj = NULL;
 	  String *common = NULL;
 	  Iterator i = First(ret_types);
@@ -1820,7 +1873,9 @@ public:
             else
 	      Printf(action, "return $r;\n");
 	    if (!wrapobj) {
-		wrapobj = NewString("\t\tswitch (get_resource_type($r)) {\n");
+		String *pointer_type = SwigPHP_pointer_type("r");
+		wrapobj = NewStringf("\t\tswitch (%s) {\n", pointer_type);
+		Delete(pointer_type);
 		common = action;
 	    } else {
 		if (common && Cmp(common, action) != 0) {
@@ -2389,12 +2444,8 @@ done:
 
     Wrapper *f = NewWrapper();
     Printf(f->def, "/* This function is designed to be called by the zend list destructors */\n");
-    Printf(f->def, "/* to typecast and do the actual destruction */\n");
-    Printf(f->def, "static void %s(zend_resource *res, const char *type_name) {\n", destructorname);
-
-    Wrapper_add_localv(f, "value", "swig_object_wrapper *value=(swig_object_wrapper *) res->ptr", NIL);
-    Wrapper_add_localv(f, "ptr", "void *ptr=value->ptr", NIL);
-    Wrapper_add_localv(f, "newobject", "int newobject=value->newobject", NIL);
+    Printf(f->def, "/* (or the SWIG\\Handle free_obj handler) to typecast and do the actual destruction */\n");
+    Printf(f->def, "static void %s(void *ptr, int newobject, const char *type_name) {\n", destructorname);
 
     emit_parameter_variables(l, f);
     emit_attach_parmmaps(l, f);
@@ -2408,7 +2459,6 @@ done:
     }
     SwigType *pt = Getattr(p, "type");
 
-    Printf(f->code, "  efree(value);\n");
     Printf(f->code, "  if (! newobject) return; /* can't delete it! */\n");
     Printf(f->code, "  arg1 = (%s)SWIG_ConvertResourceData(ptr, type_name, SWIGTYPE%s);\n", SwigType_lstr(pt, 0), SwigType_manglestr(pt));
     Printf(f->code, "  if (! arg1) zend_error(E_ERROR, \"%s resource already free'd\");\n", Char(name));
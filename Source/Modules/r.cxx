@@ -195,6 +195,43 @@ static void replaceRClass(String *tm, SwigType *type) {
   Delete(tmp); Delete(tmp_base); Delete(tmp_ref);
 }
 
+/* -------------------------------------------------------------
+ * Determine the R vector type that holds values of the given
+ * scalar C type in a %rvectorize wrapper, 0 if not supported.
+ * --------------------------------------------------------------*/
+
+static const char *vectorizeSexpType(SwigType *type) {
+  SwigType *resolved = SwigType_typedef_resolve_all(type);
+  SwigType *stripped = SwigType_strip_qualifiers(resolved);
+  const char *sexptype = 0;
+  switch (SwigType_type(stripped)) {
+  case T_BOOL:
+    sexptype = "LGLSXP";
+    break;
+  case T_SCHAR:
+  case T_UCHAR:
+  case T_SHORT:
+  case T_USHORT:
+  case T_INT:
+    sexptype = "INTSXP";
+    break;
+  case T_UINT:
+  case T_LONG:
+  case T_ULONG:
+  case T_LONGLONG:
+  case T_ULONGLONG:
+  case T_FLOAT:
+  case T_DOUBLE:
+    sexptype = "REALSXP";
+    break;
+  default:
+    break;
+  }
+  Delete(stripped);
+  Delete(resolved);
+  return sexptype;
+}
+
 class R : public Language {
 public:
   R();
@@ -204,6 +241,7 @@ public:
 
   void dispatchFunction(Node *n);
   int functionWrapper(Node *n);
+  void vectorizeFunction(Node *n, List *rnames);
   int constantWrapper(Node *n);
   int variableWrapper(Node *n);
 
@@ -1819,6 +1857,7 @@ int R::functionWrapper(Node *n) {
   Wrapper_add_localv(f, "r_vmax", "VMAXTYPE", "r_vmax = vmaxget()", NIL);
 
   String *sargs = NewString("");
+  List *rnames = NewList();
 
 
   String *s_inputTypes = NewString("");
@@ -1876,6 +1915,7 @@ int R::functionWrapper(Node *n) {
     }
 
     Printf(sargs, "%s, ", name);
+    Append(rnames, name);
 
     String *tm;
     if((tm = Getattr(p, "tmap:scoercein"))) {
@@ -2201,14 +2241,181 @@ int R::functionWrapper(Node *n) {
 
   addRegistrationRoutine(wname, addCopyParam ? nargs +1 : nargs);
 
+  if (GetFlag(n, "feature:rvectorize"))
+    vectorizeFunction(n, rnames);
+
   DelWrapper(f);
   DelWrapper(sfun);
 
+  Delete(rnames);
   Delete(sargs);
   Delete(sfname);
   return SWIG_OK;
 }
 
+/* ----------------------------------------------------------------------
+ * R::vectorizeFunction()
+ *
+ * Generates the additional wrapper requested by %rvectorize. The wrapped
+ * function is called once per element of its (recycled) vector arguments
+ * from a loop in C and the results are stored in a preallocated vector,
+ * instead of one .Call per element. NA in any argument gives NA.
+ * rnames are the names of the R arguments of the scalar wrapper.
+ * ---------------------------------------------------------------------- */
+
+void R::vectorizeFunction(Node *n, List *rnames) {
+  String *iname = Getattr(n, "sym:name");
+  String *nodeType = Getattr(n, "nodeType");
+  ParmList *l = Getattr(n, "wrap:parms");
+  Parm *p;
+  int i;
+  const char *reason = 0;
+
+  const char *rettype = vectorizeSexpType(Getattr(n, "type"));
+  if (Getattr(n, "sym:overloaded"))
+    reason = "it is overloaded";
+  else if (Cmp(nodeType, "cdecl") || processing_member_access_function || processing_class_member_function || processing_variable)
+    reason = "it is not a global function";
+  else if (!rettype)
+    reason = "the return type is not a numeric or logical scalar";
+  for (p = l; p && !reason; p = nextSibling(p)) {
+    if (checkAttribute(p, "tmap:in:numinputs", "0") || !vectorizeSexpType(Getattr(p, "type")))
+      reason = "a parameter is not a numeric or logical scalar";
+  }
+  if (reason) {
+    Swig_warning(WARN_R_VECTORIZE_IGNORED, input_file, line_number,
+		 "%%rvectorize ignored for %s as %s.\n", iname, reason);
+    return;
+  }
+
+  String *vname = Getattr(n, "feature:rvectorize");
+  vname = Cmp(vname, "1") ? Copy(vname) : NewStringf("%s_vec", iname);
+  String *wname = NewStringf("%s_vec", Getattr(n, "wrap:name"));
+  int nargs = Len(rnames);
+
+  Wrapper *f = NewWrapper();
+  Wrapper *sfun = NewWrapper();
+
+  Printv(f->def, "SWIGEXPORT SEXP\n", wname, " ( ", NIL);
+  Printf(sfun->def, "# Start of %s\n", vname);
+  Printv(sfun->def, "\n`", vname, "` = function(", NIL);
+
+  for (p = l, i = 0; p; p = nextSibling(p), i++) {
+    String *lname = Getattr(p, "lname");
+    String *decl = SwigType_lstr(Getattr(p, "type"), lname);
+    Wrapper_add_localv(f, lname, decl, NIL);
+    Delete(decl);
+  }
+  String *result_decl = SwigType_lstr(Getattr(n, "type"), Swig_cresult_name());
+  Wrapper_add_localv(f, Swig_cresult_name(), result_decl, NIL);
+  Delete(result_decl);
+  Wrapper_add_local(f, "r_nprotect", "unsigned int r_nprotect = 0");
+  Wrapper_add_localv(f, "r_ans", "SEXP", "r_ans = R_NilValue", NIL);
+  Wrapper_add_local(f, "r_n", "R_xlen_t r_n = 0");
+  Wrapper_add_local(f, "r_i", "R_xlen_t r_i");
+  Wrapper_add_localv(f, "r_out", Strcmp(rettype, "REALSXP") ? "int" : "double", "*r_out", NIL);
+
+  /* Coerce the arguments to vectors of the C types and work out the result length */
+  String *sargs = NewString("");
+  String *nacheck = NewString("");
+  String *advance = NewString("");
+  for (p = l, i = 0; p; p = nextSibling(p), i++) {
+    String *name = Getitem(rnames, i);
+    const char *sexptype = vectorizeSexpType(Getattr(p, "type"));
+    bool real = !strcmp(sexptype, "REALSXP");
+    String *len = NewStringf("r_len%d", i + 1);
+    String *pos = NewStringf("r_pos%d", i + 1);
+    String *in = NewStringf("r_in%d", i + 1);
+    Wrapper_add_localv(f, len, "R_xlen_t", len, NIL);
+    Wrapper_add_localv(f, pos, "R_xlen_t", pos, "= 0", NIL);
+    Wrapper_add_localv(f, in, real ? "double" : "int", "*", in, NIL);
+
+    Printv(f->def, i ? ", " : "", "SEXP ", name, NIL);
+    Printv(sfun->def, i ? ", " : "", name, NIL);
+    Printf(sargs, "%s, ", name);
+
+    Printf(f->code, "%s = Rf_protect(Rf_coerceVector(%s, %s));\nr_nprotect++;\n", name, name, sexptype);
+    Printf(f->code, "%s = Rf_xlength(%s);\n", len, name);
+    Printf(f->code, "%s = %s(%s);\n", in, real ? "REAL" : (strcmp(sexptype, "LGLSXP") ? "INTEGER" : "LOGICAL"), name);
+    Printf(f->code, "if (%s > r_n) r_n = %s;\n", len, len);
+
+    if (real)
+      Printf(nacheck, "%sISNA(%s[%s])", i ? " || " : "", in, pos);
+    else
+      Printf(nacheck, "%s%s[%s] == NA_INTEGER", i ? " || " : "", in, pos);
+    Printf(advance, "if (++%s == %s) %s = 0;\n", pos, len, pos);
+
+    Delete(in);
+    Delete(pos);
+    Delete(len);
+  }
+
+  /* R recycling rules: a zero length argument gives a zero length result */
+  for (i = 0; i < nargs; i++) {
+    Printf(f->code, "if (r_len%d == 0) r_n = 0;\n", i + 1);
+  }
+  if (nargs > 1) {
+    Printf(f->code, "if (r_n > 0 && (");
+    for (i = 0; i < nargs; i++) {
+      Printf(f->code, "%sr_n %% r_len%d != 0", i ? " || " : "", i + 1);
+    }
+    Printf(f->code, ")) {\n");
+    Printf(f->code, "Rf_warning(\"longer object length is not a multiple of shorter object length\");\n");
+    Printf(f->code, "}\n");
+  }
+  Printf(f->code, "r_ans = Rf_protect(Rf_allocVector(%s, r_n));\nr_nprotect++;\n", rettype);
+  Printf(f->code, "r_out = %s(r_ans);\n", Strcmp(rettype, "REALSXP") ? (Strcmp(rettype, "LGLSXP") ? "INTEGER" : "LOGICAL") : "REAL");
+
+  Printf(f->code, "for (r_i = 0; r_i < r_n; r_i++) {\n");
+  if (nargs > 0) {
+    Printf(f->code, "if (%s) {\n", nacheck);
+    Printf(f->code, "r_out[r_i] = %s;\n", Strcmp(rettype, "REALSXP") ? (Strcmp(rettype, "LGLSXP") ? "NA_INTEGER" : "NA_LOGICAL") : "NA_REAL");
+    Printf(f->code, "} else {\n");
+  }
+  for (p = l, i = 0; p; p = nextSibling(p), i++) {
+    SwigType *lt = SwigType_ltype(Getattr(p, "type"));
+    String *ltstr = SwigType_str(lt, 0);
+    Printf(f->code, "%s = (%s) r_in%d[r_pos%d];\n", Getattr(p, "lname"), ltstr, i + 1, i + 1);
+    Delete(ltstr);
+    Delete(lt);
+  }
+  Printv(f->code, emit_action(n), NIL);
+  String *out = Strcmp(rettype, "LGLSXP") ? NewStringf("(%s) %s", Strcmp(rettype, "REALSXP") ? "int" : "double", Swig_cresult_name()) : NewStringf("%s ? 1 : 0", Swig_cresult_name());
+  Printf(f->code, "r_out[r_i] = %s;\n", out);
+  Delete(out);
+  if (nargs > 0)
+    Printf(f->code, "}\n");
+  Printv(f->code, advance, "}\n", NIL);
+
+  Printv(f->code, "Rf_unprotect(r_nprotect);\n", "return r_ans;\n", NIL);
+  Printv(f->code, "fail: SWIGUNUSED;\n", NIL);
+  Printv(f->code, "  Rf_error(\"%s %s\", SWIG_ErrorType(SWIG_lasterror_code), SWIG_lasterror_msg);\n", NIL);
+  Printv(f->code, "  return R_NilValue;\n", NIL);
+  Printv(f->code, "}\n", NIL);
+
+  Printv(f->def, ")\n{\n", NIL);
+  Printv(sfun->def, ")\n{\n", NIL);
+  Printv(sfun->code, ".Call('", wname, "', ", sargs, "PACKAGE='", Rpackage, "');\n", NIL);
+  Printv(sfun->code, "\n}", NIL);
+
+  Replaceall(f->code, "$symname", iname);
+  Wrapper_print(f, f_wrapper);
+  Wrapper_print(sfun, sfile);
+  Printv(sfile, "\n# End of ", vname, "\n\n", NIL);
+
+  if (outputNamespaceInfo)
+    addNamespaceFunction(vname);
+  addRegistrationRoutine(wname, nargs);
+
+  DelWrapper(f);
+  DelWrapper(sfun);
+  Delete(sargs);
+  Delete(nacheck);
+  Delete(advance);
+  Delete(wname);
+  Delete(vname);
+}
+
 /* ----------------------------------------------------------------------
  * R::constantWrapper()
  * ---------------------------------------------------------------------- */
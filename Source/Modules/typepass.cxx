@@ -227,6 +227,16 @@ class TypePass:private Dispatcher {
 
 	  if (tname)
 	    Delete(tname);
+	  if (bcls && Getmeta(bname, "virtual")) {
+	    /* Record the virtual bases, as pointers to them cannot be cast down with a static_cast */
+	    Hash *vbases = Getattr(cls, "virtualbases");
+	    if (!vbases) {
+	      vbases = NewHash();
+	      Setattr(cls, "virtualbases", vbases);
+	      Delete(vbases);
+	    }
+	    Setattr(vbases, Getattr(bcls, "name"), bcls);
+	  }
 	  if (!bcls) {
 	    if (!clsforward && !GetFlag(cls, "feature:ignore")) {
 	      if (ispublic && !Getmeta(bname, "already_warned")) {
@@ -10,12 +10,101 @@
 
 namespace wasm {
 
+static const char *usage = "\
+Emscripten Wasm Options (available with -emwasm)\n\
+     -wasm-rawabi    - Call functions with only arithmetic and wrapped object arguments\n\
+                       through C exports instead of embind\n\
+     -wasm-finalize  - Delete objects of all classes that are garbage collected\n\
+                       without being deleted, as with %wasmfinalize\n\
+\n";
+
+/* The JS typed array for elements of type, or 0 if there is none. */
+static const char *typedArrayName(SwigType *type) {
+    SwigType *resolved = SwigType_typedef_resolve_all(type);
+    const char *name = 0;
+    switch (SwigType_type(resolved)) {
+        case T_CHAR:
+        case T_SCHAR:
+            name = "Int8Array";
+            break;
+        case T_UCHAR:
+            name = "Uint8Array";
+            break;
+        case T_SHORT:
+            name = "Int16Array";
+            break;
+        case T_USHORT:
+            name = "Uint16Array";
+            break;
+        case T_INT:
+        case T_LONG:
+            name = "Int32Array";
+            break;
+        case T_UINT:
+        case T_ULONG:
+            name = "Uint32Array";
+            break;
+        case T_FLOAT:
+            name = "Float32Array";
+            break;
+        case T_DOUBLE:
+            name = "Float64Array";
+            break;
+        default:
+            break;
+    }
+    Delete(resolved);
+    return name;
+}
+
+/* The Emscripten heap view for a typed array, and the log2 of its element
+   size. */
+static const char *typedArrayHeap(const char *array, int *shift) {
+    static const struct {
+        const char *array;
+        const char *heap;
+        int shift;
+    } heaps[] = {
+        {"Int8Array", "HEAP8", 0},     {"Uint8Array", "HEAPU8", 0},
+        {"Int16Array", "HEAP16", 1},   {"Uint16Array", "HEAPU16", 1},
+        {"Int32Array", "HEAP32", 2},   {"Uint32Array", "HEAPU32", 2},
+        {"Float32Array", "HEAPF32", 2}, {"Float64Array", "HEAPF64", 3},
+    };
+    for (size_t i = 0; i < sizeof(heaps) / sizeof(heaps[0]); i++) {
+        if (strcmp(heaps[i].array, array) == 0) {
+            *shift = heaps[i].shift;
+            return heaps[i].heap;
+        }
+    }
+    return 0;
+}
+
+/* How a parameter or the result is passed to a raw ABI export. */
+enum RawAbiKind {
+    RAW_ABI_NONE,
+    RAW_ABI_VOID,
+    RAW_ABI_NUMBER,
+    RAW_ABI_BOOL,
+    RAW_ABI_OBJECT_PTR,
+    RAW_ABI_OBJECT_REF,
+    RAW_ABI_STRING,
+    RAW_ABI_STRING_REF,
+    RAW_ABI_STRING_VIEW,
+    RAW_ABI_CSTRING
+};
+
+/* A template is compiled once into a list of segments, alternately literal
+   text and a placeholder: a '$' with the identifier characters following it.
+   replace() only records the value of a placeholder, and the code is
+   rendered when str() is called, in one pass over the segments. */
 class Template {
    public:
     Template(const String *code);
     Template(const String *code, const String *templateName);
+    Template(List *segments, const String *templateName);
     Template(const Template &other);
     ~Template();
+    static List *compile(const String *code);
     String *str();
     Template &replace(const String *pattern, const String *repl);
     Template &print(DOH *doh);
@@ -24,8 +113,13 @@ class Template {
     Template &trim();
 
    private:
+    void render();
+
+    List *segments;
+    Hash *values;
     String *code;
     String *templateName;
+    bool trimmed;
 };
 
 class EmscriptenWasm : public Language {
@@ -78,13 +172,34 @@ class EmscriptenWasm : public Language {
     String *getClassFullMemberName(Node *n);
 
     String *wrapFunction(Node *n);
+    bool wrapRawAbiFunction(Node *n);
+    bool hasCallCustomization(Node *n);
+    RawAbiKind rawAbiKind(SwigType *type, String **ctype);
+    void wrapVectorTypedArray(Node *n);
+    void wrapMapEntries(Node *n);
+    void wrapSoaStruct(Node *n);
+    void wrapVectorSoa(Node *n);
+    Node *embindBase(Node *n);
+    void wrapSecondaryBases(Node *n);
+    void wrapBaseMembers(Node *n, Node *base, Node *cls, Hash *seen);
     String *wrapWrapperFuntion(Node *n);
-    String *generateSetterFunction(Node *n);
-    String *generateGetterFunction(Node *n);
+    void wrapMemberVariable(Node *n, const String *thunk, const String *self,
+                            const String *const_self);
+    String *generateSetterFunction(Node *n, const String *func_name = 0,
+                                   const String *self = 0);
+    String *generateGetterFunction(Node *n, const String *func_name = 0,
+                                   const String *self = 0);
+    SwigType *referenceMemberClass(Node *n);
+    void markReferencedClasses(Node *n);
+    String *generateReferenceGetterFunction(Node *n, SwigType *member_class,
+                                            const String *func_name = 0,
+                                            const String *self = 0);
 
     String *generateOverloadedFunctionShadowCode(Node *n);
-    String *selectOverloadedFuntionShadowCode(String *sym_funcname,
-                                              ParmList *plist);
+    String *overloadedFunctionTarget(Node *n);
+    bool isOverloadMoreDerived(Node *a, Node *b);
+    String *jsTypeCheck(SwigType *type, const String *arg, Hash *classrefs,
+                        String *classdecls);
     bool checkHasRawPointer(SwigType *return_type, ParmList *plist);
     String *extendFuntionCode(Node *);
 
@@ -95,17 +210,22 @@ class EmscriptenWasm : public Language {
     String *wasmFunctionName(Node *n);
 
     Template getTemplate(const String *name) {
-        String *templ = Getattr(templates, name);
+        List *segments = Getattr(compiled_templates, name);
 
-        if (!templ) {
-            Printf(stderr, "Could not find template %s\n.", name);
-            SWIG_exit(EXIT_FAILURE);
+        if (!segments) {
+            String *templ = Getattr(templates, name);
+            if (!templ) {
+                Printf(stderr, "Could not find template %s\n.", name);
+                SWIG_exit(EXIT_FAILURE);
+            }
+            segments = Template::compile(templ);
+            Setattr(compiled_templates, name, segments);
+            Delete(segments);
         }
-        return Template(templ, name);
+        return Template(segments, name);
     }
 
     String *paramsToStr(ParmList *p, int t);
-    String *parmsToJsTypeStrArray(ParmList *p);
 
    private:
     File *f_begin = 0;
@@ -117,6 +237,7 @@ class EmscriptenWasm : public Language {
     File *f_overloaded_funcs = 0;
     File *f_extends = 0;
     File *f_overload_js = 0;
+    File *f_class_js = 0;
     // String *s_shadow = 0;
     File *f_shadow_js = 0;
     String* s_constant_wrapper = 0;
@@ -127,8 +248,21 @@ class EmscriptenWasm : public Language {
     String *methods = 0;
 
     Hash *templates;
+    Hash *compiled_templates;
     
     bool in_enum = false;
+
+    // -wasm-rawabi
+    bool raw_abi = false;
+    bool raw_abi_strings = false;
+    bool raw_abi_handles = false;
+    File *f_rawabi_js = 0;
+
+    // %wasmfinalize and %wasmpool
+    bool finalize_all = false;
+    bool finalize_js = false;
+    bool pool_runtime = false;
+    File *f_finalize_js = 0;
 };
 
 EmscriptenWasm::~EmscriptenWasm() {
@@ -151,18 +285,39 @@ EmscriptenWasm::~EmscriptenWasm() {
     _Free(f_overloaded_funcs);
     _Free(f_extends);
     _Free(templates);
+    _Free(compiled_templates);
     _Free(f_overload_js);
+    _Free(f_class_js);
     _Free(s_constant_wrapper);
+    _Free(f_rawabi_js);
+    _Free(f_finalize_js);
     // _Free(s_last_overloaed_fun);
 }
 
 void EmscriptenWasm::main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (argv[i]) {
+            if (strcmp(argv[i], "-wasm-rawabi") == 0) {
+                raw_abi = true;
+                Swig_mark_arg(i);
+            } else if (strcmp(argv[i], "-wasm-finalize") == 0) {
+                finalize_all = true;
+                Swig_mark_arg(i);
+            } else if (strcmp(argv[i], "-help") == 0) {
+                fputs(usage, stdout);
+            }
+        }
+    }
+
     SWIG_library_directory("wasm");
     // SWIG_library_directory("javascript");
     // SWIG_library_directory("javascript/v8");
     SWIG_typemap_lang("wasm");
     SWIG_config_file("em_wasm.swg");
     Preprocessor_define("SWIGWASM", 1);
+    if (raw_abi) {
+        Preprocessor_define("SWIGWASM_RAWABI 1", 0);
+    }
     allow_overloading();
 
     f_header = NewString("");
@@ -173,6 +328,9 @@ void EmscriptenWasm::main(int argc, char *argv[]) {
     f_overloaded_funcs = NewString("");
     f_extends = NewString("");
     f_overload_js = NewString("");
+    f_class_js = NewString("");
+    f_rawabi_js = NewString("");
+    f_finalize_js = NewString("");
     s_constant_wrapper = NewString("");
     // s_last_overloaed_fun = NewString("_");
 
@@ -181,6 +339,7 @@ void EmscriptenWasm::main(int argc, char *argv[]) {
     methods = NewString("");
 
     templates = NewHash();
+    compiled_templates = NewHash();
 }
 
 int EmscriptenWasm::top(Node *n) {
@@ -225,6 +384,7 @@ int EmscriptenWasm::top(Node *n) {
 
     /* emit code */
 
+    markReferencedClasses(n);
     Language::top(n);
 
     Dump(s_constant_wrapper, f_wrappers);
@@ -240,10 +400,23 @@ int EmscriptenWasm::top(Node *n) {
     Wrapper_pretty_print(f_init, f_begin);
 
     // shadow js
-    String *emwasm_js_checktype = Getattr(templates, "emwasm_js_checktype");
-    Printf(f_shadow_js, "%s\n\n", emwasm_js_checktype);
-    Printf(f_shadow_js, "__ATMAIN__.push( () => {\n");
+    if (raw_abi_strings) {
+        Template strings = getTemplate("emwasm_js_strings");
+        Printf(f_shadow_js, "\n%s\n", strings.trim().str());
+    }
+    if (raw_abi_handles) {
+        Template handles = getTemplate("emwasm_js_rawabi_handles");
+        Printf(f_shadow_js, "\n%s\n", handles.trim().str());
+    }
+    if (finalize_js) {
+        Template finalize = getTemplate("emwasm_js_finalize");
+        Printf(f_shadow_js, "\n%s\n", finalize.trim().str());
+    }
+    Printf(f_shadow_js, "\n__ATMAIN__.push( () => {\n");
+    Dump(f_rawabi_js, f_shadow_js);
+    Dump(f_class_js, f_shadow_js);
     Dump(f_overload_js, f_shadow_js);
+    Dump(f_finalize_js, f_shadow_js);
     Printf(f_shadow_js, "});\n");
 
     return SWIG_OK;
@@ -277,36 +450,7 @@ int EmscriptenWasm::functionHandler(Node *n) {
     Node *overload = Getattr(n, "sym:overloaded");
     // shadow js
     if (overload && GetFlag(n, "__wasm_wraped") == 0) {
-        Node *classn = getCurrentClass();
-        String *wasm_fname = Getattr(n, "sym:name");
-        int isstatic =
-            getCurrentClass() && Swig_storage_isstatic(n) &&
-            !(SmartPointer && Getattr(n, "allocate:smartpointeraccess"));
-
-        if (classn) {
-            String *wasm_cname = Getattr(classn, "sym:name");
-            if (isstatic) {
-                Printf(f_overload_js, "    Module['%s'].%s = function () {\n",
-                       wasm_cname, wasm_fname);
-            } else {
-                Printf(f_overload_js,
-                       "    Module['%s'].prototype['%s'] = function () {\n",
-                       wasm_cname, wasm_fname);
-            }
-        } else {
-            Printf(f_overload_js, "    Module.%s = function () {\n",
-                   wasm_fname);
-        }
-        Node *nod = overload;
-
-        while (nod) {
-            generateOverloadedFunctionShadowCode(nod);
-            nod = Getattr(nod, "sym:nextSibling");
-        }
-        Printf(f_overload_js,
-               "        throw('Arguments are illegal! No overloaded function "
-               "was matched!');\n");
-        Printf(f_overload_js, "    };\n\n");
+        generateOverloadedFunctionShadowCode(overload);
     }
 
     wrapFunction(n);
@@ -378,22 +522,67 @@ int EmscriptenWasm::membervariableHandler(Node *n) {
     Language::membervariableHandler(n);
     // printNode(n, __FUNCTION__);
 
-    String *name = getClassFullMemberName(n);
+    wrapMemberVariable(n, 0, 0, 0);
+    return SWIG_OK;
+}
+
+/* -----------------------------------------------------------------------------
+ * wrapMemberVariable()
+ *
+ * Adds the property of member variable n to the current class.  A member of
+ * the class itself has thunk 0 and is bound directly where embind can do so.
+ * A member of a base class which is not the embind base is read and written
+ * by the thunks <thunk>_get and <thunk>_set, which reach it from the class
+ * through the expressions const_self and self.
+ * -----------------------------------------------------------------------------
+ */
+
+void EmscriptenWasm::wrapMemberVariable(Node *n, const String *thunk,
+                                        const String *self,
+                                        const String *const_self) {
     String *wasm_name = Getattr(n, "sym:name");
-    if (checkHasRawPointer(Getattr(n, "type"), 0)) {
+    String *getter_name = thunk ? NewStringf("%s_get", thunk) : 0;
+    String *setter_name = thunk ? NewStringf("%s_set", thunk) : 0;
+    SwigType *member_class = referenceMemberClass(n);
+    String *getter = 0;
+    String *setter = 0;
+    if (member_class) {
+        getter = generateReferenceGetterFunction(n, member_class, getter_name,
+                                                 const_self);
+        if (!checkHasRawPointer(Getattr(n, "type"), 0) && is_assignable(n)) {
+            setter = generateSetterFunction(n, setter_name, self);
+        }
+        Delete(member_class);
+    } else if (checkHasRawPointer(Getattr(n, "type"), 0)) {
         // Printf(stdout, "Donot support variable[%s %s] which is pointer type.\n",
             //    SwigType_str(Getattr(n, "type"), 0), getClassFullMemberName(n));
-        Delete(name);
-        name = generateGetterFunction(n);
+        getter = generateGetterFunction(n, getter_name, const_self);
+    } else if (thunk || Getattr(n, "bitfield")) {
+        // a bitfield has no member pointer
+        getter = generateGetterFunction(n, getter_name, const_self);
+        if (is_assignable(n)) {
+            setter = generateSetterFunction(n, setter_name, self);
+        }
+    } else {
+        getter = getClassFullMemberName(n);
     }
 
-    Template tmpl = getTemplate("emwasm_class_property");
-    tmpl.replace("$name", wasm_name).replace("$value", name);
+    Template tmpl("");
+    if (setter) {
+        tmpl = getTemplate("emwasm_class_property_accessors");
+        tmpl.replace("$setter", setter);
+    } else {
+        tmpl = getTemplate("emwasm_class_property");
+    }
+    tmpl.replace("$name", wasm_name).replace("$value", getter);
     Printf(f_wrappers, "%s    %s\n", tab4, tmpl.trim().str());
 
-    Delete(name);
-    return SWIG_OK;
+    Delete(setter);
+    Delete(getter);
+    Delete(setter_name);
+    Delete(getter_name);
 }
+
 int EmscriptenWasm::staticmembervariableHandler(Node *n) {
     Language::staticmembervariableHandler(n);
     if (checkHasRawPointer(Getattr(n, "type"), 0)) {
@@ -466,21 +655,19 @@ int EmscriptenWasm::destructorHandler(Node *n) {
 int EmscriptenWasm::classHandler(Node *n) {
     String *classtype = Getattr(n, "classtype");
     String *name = Getattr(n, "sym:name");
-    List *bases = Getattr(n, "allbases");
-    int bases_len = Len(bases);
+    Node *base_n = embindBase(n);
 
     // printNode(n, __FUNCTION__);
     Printf(f_header, "const std::string __swig__%s = \"%s\";\n", name,
            classtype);
     Append(f_wrappers, "\n");
-    if (bases_len == 0) {
+    if (!base_n) {
         Template wasm_class = getTemplate("emwasm_class");
 
         wasm_class.replace("$class_type", classtype)
             .replace("$wasm_classname", name);
         Printf(f_wrappers, "%s%s\n", tab4, wasm_class.trim().str());
-    } else if (bases_len > 0) {
-        Node *base_n = Getitem(bases, 0);
+    } else {
         String *base_classtype = Getattr(base_n, "classtype");
         Template wasm_class = getTemplate("emwasm_class_with_base");
 
@@ -488,22 +675,47 @@ int EmscriptenWasm::classHandler(Node *n) {
             .replace("$base_class", base_classtype)
             .replace("$wasm_classname", name);
         Printf(f_wrappers, "%s%s\n", tab4, wasm_class.trim().str());
-
-        if (bases_len > 1) {
-            Printf(stdout, "Warning: Only surport ONE base class.");
-            for (int i = 1; i < bases_len; i++) {
-                Node *bn = Getitem(bases, i);
-                Printf(stdout, "(%s) ", Getattr(bn, "classtype"));
-            }
-            Printf(stdout, "will be ignore!");
-        }
     }
     // add type to class property
     Printf(f_wrappers, "        .class_property(\"__type\", &__swig__%s)\n",
            name);
+
+    // std::shared_ptr handles are used for references to members and for
+    // pooled objects
+    if (GetFlag(n, "wasm:shared") || GetFlag(n, "feature:wasm:pool")) {
+        Template smart_ptr = getTemplate("emwasm_class_shared");
+        smart_ptr.replace("$class_type", classtype)
+            .replace("$wasm_classname", name);
+        Printf(f_wrappers, "%s    %s\n", tab4, smart_ptr.trim().str());
+    }
+
+    // objects constructed from JS are allocated from a pool and held by a
+    // std::shared_ptr, whose deleter returns them to the pool
+    if (GetFlag(n, "feature:wasm:pool") && !pool_runtime) {
+        Template pool = getTemplate("emwasm_pool");
+        Printf(f_extends, "%s\n", pool.trim().str());
+        pool_runtime = true;
+    }
+
+    bool finalize = Getattr(n, "feature:wasm:finalize")
+                        ? GetFlag(n, "feature:wasm:finalize") != 0
+                        : finalize_all;
+    if (finalize) {
+        Printf(f_finalize_js,
+               "    Module['%s'] = __swig_finalize_class(Module['%s']);\n",
+               name, name);
+        finalize_js = true;
+    }
     // Printf(f_wrappers, "        .property(\"__type\", &__swig__%s)\n", name);
 
     Language::classHandler(n);
+    wrapVectorTypedArray(n);
+    wrapMapEntries(n);
+    if (GetFlag(n, "feature:wasm:soa")) {
+        wrapSoaStruct(n);
+    }
+    wrapVectorSoa(n);
+    wrapSecondaryBases(n);
 
     Printf(f_wrappers, "        ;\n\n");
     return SWIG_OK;
@@ -605,6 +817,7 @@ int EmscriptenWasm::fragmentDirective(Node *n) {
         // Printf(stdout, "%s:\n%s\n\n", Getattr(n, "value"), Getattr(n,
         // "code"));
         Setattr(templates, Getattr(n, "value"), Getattr(n, "code"));
+        Delattr(compiled_templates, Getattr(n, "value"));
         return SWIG_OK;
     } else {
         return Language::fragmentDirective(n);
@@ -613,9 +826,18 @@ int EmscriptenWasm::fragmentDirective(Node *n) {
 
 int EmscriptenWasm::_classConstructorWrapper(Node *n) {
     ParmList *plist = Getattr(n, "parms");
-    Template tmpl = getTemplate("emwasm_class_constructor");
+    Node *classn = getCurrentClass();
     String *pstr = paramsToStr(plist, 1);
-    tmpl.replace("$param_types", pstr);
+    Template tmpl("");
+    if (GetFlag(classn, "feature:wasm:pool")) {
+        if (Len(pstr)) Insert(pstr, 0, ", ");
+        tmpl = getTemplate("emwasm_class_pool_constructor");
+        tmpl.replace("$class_type", Getattr(classn, "classtype"))
+            .replace("$param_types", pstr);
+    } else {
+        tmpl = getTemplate("emwasm_class_constructor");
+        tmpl.replace("$param_types", pstr);
+    }
     Delete(pstr);
     Printf(f_wrappers, "%s    %s\n", tab4, tmpl.trim().str());
     return SWIG_OK;
@@ -643,7 +865,15 @@ String *EmscriptenWasm::wrapFunction(Node *n) {
 
     String *fname, *wasm_name;
 
-    wasm_name = wasmFunctionName(n);
+    if (raw_abi && wrapRawAbiFunction(n)) {
+        // functions taking objects are also registered with embind, under
+        // another name, for the handles the export cannot take
+        String *embind_name = Getattr(n, "wasm:rawabi:embind");
+        if (!embind_name) return 0;
+        wasm_name = Copy(embind_name);
+    } else {
+        wasm_name = wasmFunctionName(n);
+    }
     if (overload || is_extend || is_template) {
         fname = wrapWrapperFuntion(n);
     } else {
@@ -674,6 +904,544 @@ String *EmscriptenWasm::wrapFunction(Node *n) {
     return func_str;
 }
 
+/* -----------------------------------------------------------------------------
+ * wrapVectorTypedArray()
+ *
+ * Adds view(), assign(TypedArray) and copyTo(TypedArray) to a std::vector
+ * of an arithmetic type, so the elements can be accessed from JS without a
+ * call per element.
+ * -----------------------------------------------------------------------------
+ */
+
+void EmscriptenWasm::wrapVectorTypedArray(Node *n) {
+    String *name = Getattr(n, "name");
+    if (!SwigType_istemplate(name)) return;
+
+    String *prefix = SwigType_templateprefix(name);
+    bool is_vector = Equal(prefix, "std::vector");
+    Delete(prefix);
+    if (!is_vector) return;
+
+    String *args = SwigType_templateargs(name);
+    String *parms = NewString(Char(args) + 1);
+    List *parmlist = SwigType_parmlist(parms);
+    bool supported = typedArrayName(Getitem(parmlist, 0)) != 0;
+
+    if (supported) {
+        Template accessors = getTemplate("emwasm_vector_typed_array");
+        accessors.replace("$class_type", Getattr(n, "classtype"))
+            .replace("$wasm_classname", Getattr(n, "sym:name"));
+        Printf(f_extends, "%s\n\n", accessors.trim().str());
+
+        Template functions = getTemplate("emwasm_vector_typed_array_functions");
+        functions.replace("$wasm_classname", Getattr(n, "sym:name"));
+        Printf(f_wrappers, "%s    %s\n", tab4, functions.trim().str());
+    }
+
+    Delete(parmlist);
+    Delete(parms);
+    Delete(args);
+}
+
+/* -----------------------------------------------------------------------------
+ * wrapMapEntries()
+ *
+ * Adds entries(offset, count, keys, values) and entriesAfter(key, count, keys,
+ * values) to a std::map whose key and value types are arithmetic, which copy
+ * a batch of entries into two typed arrays, and makes the map iterable from
+ * JS in batches, each resuming after the last key of the previous one.
+ * -----------------------------------------------------------------------------
+ */
+
+void EmscriptenWasm::wrapMapEntries(Node *n) {
+    String *name = Getattr(n, "name");
+    if (!SwigType_istemplate(name)) return;
+
+    String *prefix = SwigType_templateprefix(name);
+    bool is_map = Equal(prefix, "std::map");
+    Delete(prefix);
+    if (!is_map) return;
+
+    String *args = SwigType_templateargs(name);
+    String *parms = NewString(Char(args) + 1);
+    List *parmlist = SwigType_parmlist(parms);
+    SwigType *key_type = Getitem(parmlist, 0);
+    SwigType *value_type = Getitem(parmlist, 1);
+    const char *key_array = typedArrayName(key_type);
+    const char *value_array = value_type ? typedArrayName(value_type) : 0;
+
+    if (key_array && value_array) {
+        String *key_str = SwigType_str(key_type, 0);
+        String *value_str = SwigType_str(value_type, 0);
+
+        Template entries = getTemplate("emwasm_map_entries");
+        entries.replace("$class_type", Getattr(n, "classtype"))
+            .replace("$wasm_classname", Getattr(n, "sym:name"))
+            .replace("$key_type", key_str)
+            .replace("$value_type", value_str);
+        Printf(f_extends, "%s\n\n", entries.trim().str());
+
+        Template functions = getTemplate("emwasm_map_entries_functions");
+        functions.replace("$wasm_classname", Getattr(n, "sym:name"));
+        Printf(f_wrappers, "%s    %s\n", tab4, functions.trim().str());
+
+        Template iterator = getTemplate("emwasm_js_map_iterator");
+        iterator.replace("$wasm_classname", Getattr(n, "sym:name"))
+            .replace("$key_array", key_array)
+            .replace("$value_array", value_array);
+        Printf(f_class_js, "    %s\n\n", iterator.trim().str());
+
+        Delete(value_str);
+        Delete(key_str);
+    }
+
+    Delete(parmlist);
+    Delete(parms);
+    Delete(args);
+}
+
+/* -----------------------------------------------------------------------------
+ * wrapRawAbiFunction()
+ *
+ * With -wasm-rawabi, a function whose parameters are all arithmetic types or
+ * pointers and references to wrapped classes, and whose result is void or
+ * arithmetic, is exported as an extern "C" function instead of being
+ * registered with embind.  Objects are passed as the address held by their
+ * embind handle.  The JS function calling the export is added to the module
+ * or class in the _post.js file.  Returns false if the function is not
+ * eligible.
+ *
+ * The address of an object is only passed when __swig_raw_handle() finds a
+ * live handle of exactly the class expected.  Otherwise, e.g. for an object of
+ * a derived class whose base class subobject is at another address, the JS
+ * function calls the function registered with embind as __<name>_embind,
+ * whose name is left in the wasm:rawabi:embind attribute.
+ *
+ * The export calls the function itself, so functions with %exception,
+ * %catches or a contract, or with typemaps for their arguments or result,
+ * keep the embind path, which wraps them as without -wasm-rawabi.
+ *
+ * Once std_string.i has been included, strings are also accepted.  They are
+ * passed in as a pointer and length into the wasm heap, written there by
+ * __swig_string_in() in the _post.js file, and returned as the address of a
+ * swig_wasm_string holding the pointer and length of the result, which
+ * __swig_string_out() decodes.
+ * -----------------------------------------------------------------------------
+ */
+
+bool EmscriptenWasm::wrapRawAbiFunction(Node *n) {
+    Node *classn = getCurrentClass();
+    int isstatic = classn && Swig_storage_isstatic(n) &&
+                   !(SmartPointer && Getattr(n, "allocate:smartpointeraccess"));
+    ParmList *plist = Getattr(n, "parms");
+
+    if (GetFlag(n, "feature:extend") || Getattr(n, "template") ||
+        emit_isvarargs(plist) || hasCallCustomization(n)) {
+        return false;
+    }
+
+    String *rctype = 0;
+    RawAbiKind rkind = rawAbiKind(Getattr(n, "type"), &rctype);
+    if (rkind == RAW_ABI_NONE || rkind == RAW_ABI_OBJECT_PTR ||
+        rkind == RAW_ABI_OBJECT_REF) {
+        Delete(rctype);
+        return false;
+    }
+    if (rkind == RAW_ABI_STRING || rkind == RAW_ABI_STRING_REF ||
+        rkind == RAW_ABI_STRING_VIEW || rkind == RAW_ABI_CSTRING) {
+        Delete(rctype);
+        rctype = NewString("swig_wasm_string *");
+    }
+
+    String *cparms = NewStringEmpty();
+    String *cargs = NewStringEmpty();
+    String *jsparms = NewStringEmpty();
+    String *jsargs = NewStringEmpty();
+    List *checks = NewList();
+    bool eligible = true;
+    bool string_args = false;
+    int pos = 0;
+
+    if (classn && !isstatic) {
+        Printf(cparms, "%s *self", Getattr(classn, "classtype"));
+        Printf(jsargs, "this.$$.ptr");
+        String *check = NewStringf("__swig_raw_handle(this, Module['%s'])",
+                                   Getattr(classn, "sym:name"));
+        Append(checks, check);
+        Delete(check);
+    }
+    for (Parm *p = plist; p; p = nextSibling(p), pos++) {
+        String *ctype = 0;
+        String *arg = NewStringf("a%d", pos);
+        RawAbiKind kind = rawAbiKind(Getattr(p, "type"), &ctype);
+
+        if (kind == RAW_ABI_NONE || kind == RAW_ABI_VOID) {
+            eligible = false;
+            Delete(arg);
+            Delete(ctype);
+            break;
+        }
+        Printf(cparms, "%s%s%s%s", Len(cparms) ? ", " : "", ctype,
+               Strchr(ctype, '*') ? "" : " ", arg);
+        Append(cargs, pos ? ", " : "");
+        Printf(jsparms, "%s%s", pos ? ", " : "", arg);
+        if (Len(jsargs)) Append(jsargs, ", ");
+        bool is_object = kind == RAW_ABI_OBJECT_REF || kind == RAW_ABI_OBJECT_PTR;
+        String *cls_name =
+            is_object ? Getattr(classLookup(Getattr(p, "type")), "sym:name") : 0;
+        String *check = 0;
+        switch (kind) {
+            case RAW_ABI_OBJECT_REF:
+                Printf(cargs, "*%s", arg);
+                Printf(jsargs, "%s.$$.ptr", arg);
+                check = NewStringf("__swig_raw_handle(%s, Module['%s'])", arg,
+                                   cls_name);
+                break;
+            case RAW_ABI_OBJECT_PTR:
+                Append(cargs, arg);
+                Printf(jsargs, "(%s === null ? 0 : %s.$$.ptr)", arg, arg);
+                check = NewStringf(
+                    "%s === null || __swig_raw_handle(%s, Module['%s'])", arg,
+                    arg, cls_name);
+                break;
+            case RAW_ABI_STRING:
+            case RAW_ABI_STRING_REF:
+            case RAW_ABI_STRING_VIEW:
+            case RAW_ABI_CSTRING:
+                if (kind == RAW_ABI_CSTRING) {
+                    // NUL terminated by __swig_string_in()
+                    Append(cargs, arg);
+                    Printf(jsargs, "__swig_string_in(%s)", arg);
+                } else {
+                    // the length is set by __swig_string_in(), which is
+                    // evaluated first
+                    Printf(cparms, ", size_t %s_len", arg);
+                    Printf(cargs, "%s(%s, %s_len)",
+                           kind == RAW_ABI_STRING_VIEW ? "std::string_view"
+                                                       : "std::string",
+                           arg, arg);
+                    Printf(jsargs,
+                           "__swig_string_in(%s), __swig_string_length", arg);
+                }
+                string_args = true;
+                break;
+            default:
+                Append(cargs, arg);
+                Append(jsargs, arg);
+                break;
+        }
+        if (check) {
+            Append(checks, check);
+            Delete(check);
+        }
+        Delete(arg);
+        Delete(ctype);
+    }
+
+    if (eligible) {
+        String *wasm_fname = wasmFunctionName(n);
+        String *export_name = NewStringEmpty();
+        String *call = NewStringEmpty();
+
+        if (classn) {
+            Printf(export_name, "swig_raw_%s_%s", Getattr(classn, "sym:name"),
+                   wasm_fname);
+            if (isstatic) {
+                String *name = getClassFullMemberName(n);
+                Append(call, name);
+                Delete(name);
+            } else {
+                Printf(call, "self->%s", Getattr(n, "name"));
+            }
+        } else {
+            Printf(export_name, "swig_raw_%s", wasm_fname);
+            Append(call, Getattr(n, "name"));
+        }
+        Printf(call, "(%s)", cargs);
+
+        if (Len(cparms) == 0) Append(cparms, "void");
+        Printf(f_overloaded_funcs, "extern \"C\" EMSCRIPTEN_KEEPALIVE %s%s%s(%s) {\n",
+               rctype, Strchr(rctype, '*') ? "" : " ", export_name, cparms);
+        switch (rkind) {
+            case RAW_ABI_VOID:
+                Printf(f_overloaded_funcs, "    %s;\n", call);
+                break;
+            case RAW_ABI_STRING:
+                // keep the result alive until it has been decoded
+                Printf(f_overloaded_funcs,
+                       "    swig_wasm_string_value = %s;\n"
+                       "    return swig_wasm_string_result(swig_wasm_string_value.data(), swig_wasm_string_value.size());\n",
+                       call);
+                break;
+            case RAW_ABI_STRING_REF:
+                Printf(f_overloaded_funcs,
+                       "    const std::string &result = %s;\n"
+                       "    return swig_wasm_string_result(result.data(), result.size());\n",
+                       call);
+                break;
+            case RAW_ABI_STRING_VIEW:
+                Printf(f_overloaded_funcs,
+                       "    std::string_view result = %s;\n"
+                       "    return swig_wasm_string_result(result.data(), result.size());\n",
+                       call);
+                break;
+            case RAW_ABI_CSTRING:
+                Printf(f_overloaded_funcs,
+                       "    const char *result = %s;\n"
+                       "    return swig_wasm_string_result(result, result ? strlen(result) : 0);\n",
+                       call);
+                break;
+            default:
+                Printf(f_overloaded_funcs, "    return %s;\n", call);
+                break;
+        }
+        Printf(f_overloaded_funcs, "}\n\n");
+
+        if (classn) {
+            String *wasm_cname = Getattr(classn, "sym:name");
+            if (isstatic) {
+                Printf(f_rawabi_js, "    Module['%s'].%s = function (%s) {\n",
+                       wasm_cname, wasm_fname, jsparms);
+            } else {
+                Printf(f_rawabi_js,
+                       "    Module['%s'].prototype['%s'] = function (%s) {\n",
+                       wasm_cname, wasm_fname, jsparms);
+            }
+        } else {
+            Printf(f_rawabi_js, "    Module.%s = function (%s) {\n", wasm_fname,
+                   jsparms);
+        }
+
+        String *jscall = NewStringf("Module._%s(%s)", export_name, jsargs);
+        if (rkind == RAW_ABI_BOOL) {
+            Append(jscall, " !== 0");
+        } else if (Equal(rctype, "unsigned int") ||
+                   Equal(rctype, "unsigned long") || Equal(rctype, "size_t")) {
+            // wasm returns i32, which JS reads as signed
+            Append(jscall, " >>> 0");
+        } else if (rkind == RAW_ABI_STRING || rkind == RAW_ABI_STRING_REF ||
+                   rkind == RAW_ABI_STRING_VIEW || rkind == RAW_ABI_CSTRING) {
+            Insert(jscall, 0, "__swig_string_out(");
+            Append(jscall, ")");
+        }
+        String *body = NewStringEmpty();
+        const char *ret = rkind == RAW_ABI_VOID ? "" : "return ";
+        if (string_args) {
+            // strings written by nested calls are released by those calls
+            Printf(body,
+                   "        const used = __swig_string_scratch_used;\n"
+                   "        const allocs = __swig_string_allocs.length;\n"
+                   "        try {\n"
+                   "            %s%s;\n"
+                   "        } finally {\n"
+                   "            __swig_string_release(used, allocs);\n"
+                   "        }\n",
+                   ret, jscall);
+        } else {
+            Printf(body, "        %s%s;\n", ret, jscall);
+        }
+        if (Len(checks)) {
+            String *condition = NewStringEmpty();
+            for (int i = 0; i < Len(checks); i++) {
+                String *check = Getitem(checks, i);
+                bool parens = Len(checks) > 1 && Strstr(check, "||");
+                Printf(condition, "%s%s%s%s", i ? " &&\n            " : "",
+                       parens ? "(" : "", check, parens ? ")" : "");
+            }
+            String *embind_name = NewStringf("__%s_embind", wasm_fname);
+            String *fallback;
+            if (!classn) {
+                fallback = NewStringf("Module.%s", embind_name);
+            } else if (isstatic) {
+                fallback = NewStringf("Module['%s'].%s",
+                                      Getattr(classn, "sym:name"), embind_name);
+            } else {
+                fallback = NewStringf("this.%s", embind_name);
+            }
+            Insert(body, 0, "    ");
+            Replaceall(body, "\n", "\n    ");
+            Printf(f_rawabi_js,
+                   "        if (%s) {\n"
+                   "%s    }\n"
+                   "        return %s(%s);\n",
+                   condition, body, fallback, jsparms);
+            Setattr(n, "wasm:rawabi:embind", embind_name);
+            raw_abi_handles = true;
+            Delete(fallback);
+            Delete(embind_name);
+            Delete(condition);
+        } else {
+            Printf(f_rawabi_js, "%s", body);
+        }
+        Printf(f_rawabi_js, "    };\n\n");
+        Delete(body);
+
+        if (string_args || Equal(rctype, "swig_wasm_string *")) {
+            raw_abi_strings = true;
+        }
+
+        Delete(jscall);
+        Delete(call);
+        Delete(export_name);
+        Delete(wasm_fname);
+    }
+
+    Delete(checks);
+    Delete(jsargs);
+    Delete(jsparms);
+    Delete(cargs);
+    Delete(cparms);
+    Delete(rctype);
+    return eligible;
+}
+
+/* Whether code is wrapped around the call of function n, by %exception,
+   %catches, a contract or typemaps, which a raw ABI export would leave out. */
+bool EmscriptenWasm::hasCallCustomization(Node *n) {
+    if (Getattr(n, "feature:except") || Getattr(n, "feature:catches") ||
+        Getattr(n, "feature:contract"))
+        return true;
+
+    ParmList *plist = Getattr(n, "parms");
+    static const char *parm_methods[] = {"in", "check", "argout", "freearg", 0};
+    for (int i = 0; parm_methods[i]; i++) {
+        String *attr = NewStringf("tmap:%s", parm_methods[i]);
+        Swig_typemap_attach_parms(parm_methods[i], plist, 0);
+        bool found = false;
+        for (Parm *p = plist; p && !found; p = nextSibling(p)) {
+            if (Getattr(p, attr)) found = true;
+        }
+        Delete(attr);
+        if (found) return true;
+    }
+    String *tm = Swig_typemap_lookup("out", n, Swig_cresult_name(), 0);
+    bool found = tm != 0;
+    Delete(tm);
+    return found;
+}
+
+/* Classifies type for the raw ABI, setting ctype to the C type used for it
+   by the export.  For strings passed in, other than const char *, the export
+   also takes the length. */
+RawAbiKind EmscriptenWasm::rawAbiKind(SwigType *type, String **ctype) {
+    RawAbiKind kind = RAW_ABI_NONE;
+    SwigType *resolved = SwigType_typedef_resolve_all(type);
+    SwigType *stripped = SwigType_strip_qualifiers(resolved);
+    bool is_ref = SwigType_isreference(stripped);
+    bool is_ptr = SwigType_ispointer(stripped);
+    bool strings = Getattr(templates, "emwasm_js_strings") != 0;
+    String *base_str = SwigType_base(stripped);
+
+    if (strings && (Equal(base_str, "std::string") ||
+                    Equal(base_str, "std::string_view"))) {
+        SwigType *referenced = Copy(resolved);
+        bool is_view = Equal(base_str, "std::string_view");
+        if (is_ref) SwigType_del_reference(referenced);
+        if (!SwigType_ispointer(referenced) &&
+            (!is_ref || SwigType_isconst(referenced))) {
+            kind = is_view ? RAW_ABI_STRING_VIEW
+                           : (is_ref ? RAW_ABI_STRING_REF : RAW_ABI_STRING);
+        }
+        Delete(referenced);
+    } else if (strings && is_ptr && SwigType_type(stripped) == T_STRING) {
+        SwigType *pointee = Copy(resolved);
+        if (SwigType_isconst(SwigType_del_pointer(pointee))) {
+            kind = RAW_ABI_CSTRING;
+        }
+        Delete(pointee);
+    }
+    Delete(base_str);
+    if (kind != RAW_ABI_NONE) {
+        // how a string is passed in; a string result is returned through a
+        // swig_wasm_string
+        *ctype = NewString("const char *");
+        Delete(stripped);
+        Delete(resolved);
+        return kind;
+    }
+
+    if (is_ref || is_ptr) {
+        SwigType *base = Copy(stripped);
+        SwigType_del_element(base);
+        SwigType *referenced = Copy(resolved);
+        bool const_ref =
+            is_ref && SwigType_isconst(SwigType_del_reference(referenced));
+        Delete(referenced);
+        switch (SwigType_type(base)) {
+            case T_CHAR:
+            case T_SCHAR:
+            case T_UCHAR:
+            case T_SHORT:
+            case T_USHORT:
+            case T_INT:
+            case T_UINT:
+            case T_LONG:
+            case T_ULONG:
+            case T_FLOAT:
+            case T_DOUBLE:
+                // arithmetic values passed by const reference
+                if (const_ref) {
+                    kind = RAW_ABI_NUMBER;
+                    *ctype = SwigType_str(base, 0);
+                }
+                break;
+            case T_BOOL:
+                if (const_ref) {
+                    kind = RAW_ABI_BOOL;
+                    *ctype = NewString("bool");
+                }
+                break;
+            case T_USER: {
+                Node *cls = classLookup(base);
+                if (cls && Getattr(cls, "sym:name")) {
+                    kind = is_ref ? RAW_ABI_OBJECT_REF : RAW_ABI_OBJECT_PTR;
+                    *ctype = NewStringf("%s *", Getattr(cls, "classtype"));
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        Delete(base);
+    } else {
+        switch (SwigType_type(stripped)) {
+            case T_VOID:
+                kind = RAW_ABI_VOID;
+                *ctype = NewString("void");
+                break;
+            case T_CHAR:
+            case T_SCHAR:
+            case T_UCHAR:
+            case T_SHORT:
+            case T_USHORT:
+            case T_INT:
+            case T_UINT:
+            case T_LONG:
+            case T_ULONG:
+            case T_FLOAT:
+            case T_DOUBLE:
+                kind = RAW_ABI_NUMBER;
+                *ctype = SwigType_str(stripped, 0);
+                break;
+            case T_BOOL:
+                kind = RAW_ABI_BOOL;
+                *ctype = NewString("bool");
+                break;
+            default:
+                // 32 bits wide in wasm32
+                if (Equal(stripped, "size_t") || Equal(stripped, "ptrdiff_t")) {
+                    kind = RAW_ABI_NUMBER;
+                    *ctype = Copy(stripped);
+                }
+                break;
+        }
+    }
+
+    Delete(stripped);
+    Delete(resolved);
+    return kind;
+}
+
 String *EmscriptenWasm::wrapWrapperFuntion(Node *n) {
     Node *classn = getCurrentClass();
     String *name = Getattr(n, "name");
@@ -739,11 +1507,22 @@ String *EmscriptenWasm::wrapWrapperFuntion(Node *n) {
     return func_name;
 }
 
-String *EmscriptenWasm::generateGetterFunction(Node *n) {
+/* -----------------------------------------------------------------------------
+ * generateGetterFunction()
+ *
+ * Emits a getter for member variable n of the current class, named func_name
+ * or __<class>_get_<member>, which reads the member from the expression self,
+ * "self" by default.  A pointer member is returned as a copy of the value it
+ * points to, or null, and a bitfield, which cannot be referred to, by value.
+ * -----------------------------------------------------------------------------
+ */
+
+String *EmscriptenWasm::generateGetterFunction(Node *n, const String *func_name,
+                                               const String *self) {
     Node *classn = getCurrentClass();
     String* cls_name = Getattr(classn, "sym:name");
     String *pname = Getattr(n, "sym:name");
-    SwigType* type = Copy(Getattr(n, "type"));
+    SwigType* type = SwigType_typedef_resolve_all(Getattr(n, "type"));
 
     bool is_pointer = checkHasRawPointer(type, 0);
     if (is_pointer) {
@@ -752,30 +1531,549 @@ String *EmscriptenWasm::generateGetterFunction(Node *n) {
     String *class_type = Getattr(classn, "classtype");
     String *pcxx_name = Getattr(n, "name");
 
-    String *func_name = NewStringEmpty();
-    Printf(func_name, "__%s_get_%s", cls_name, pname);
+    String *getter = func_name ? NewString(func_name)
+                               : NewStringf("__%s_get_%s", cls_name, pname);
+    if (!self) self = "self";
     if (is_pointer) {
         Printf(f_extends, "val %s(const %s& self) {\n"
-            "    if (!self.%s) return val::null();\n"
-            "    return val(*(self.%s));\n}\n\n",
-            func_name, class_type,
-            pcxx_name, pcxx_name
+            "    if (!%s.%s) return val::null();\n"
+            "    return val(*(%s.%s));\n}\n\n",
+            getter, class_type,
+            self, pcxx_name, self, pcxx_name
             );
     } else {
-        Printf(f_extends, "const %s& %s(const %s& self) {\n"
-           "    return (self.%s);\n}\n\n",
-           SwigType_str(type, 0), func_name, class_type, pcxx_name
+        SwigType *value_type = SwigType_strip_qualifiers(type);
+        String *tstr = SwigType_str(value_type, 0);
+        Printf(f_extends, "%s%s%s %s(const %s& self) {\n"
+           "    return (%s.%s);\n}\n\n",
+           Getattr(n, "bitfield") ? "" : "const ", tstr,
+           Getattr(n, "bitfield") ? "" : "&", getter, class_type, self, pcxx_name
           );
+        Delete(tstr);
+        Delete(value_type);
     }
 
     Delete(type);
-    return func_name;
+    return getter;
+}
+/* -----------------------------------------------------------------------------
+ * wrapSoaStruct()
+ *
+ * For a struct with %wasmsoa, adds a JS class <Struct>SoA viewing an array of
+ * the structs in the wasm heap, which reads and writes the arithmetic fields
+ * of the elements through the heap views at their offsets, and copies one
+ * field of many elements into a typed array.  The offsets and size come from
+ * offsetof and sizeof, through a class function called once.  offsetof needs
+ * a standard layout class, so polymorphic classes and classes with non-public
+ * data members are rejected here and the rest by a static_assert.  Bitfields
+ * have no offset and are left out.
+ * -----------------------------------------------------------------------------
+ */
+
+void EmscriptenWasm::wrapSoaStruct(Node *n) {
+    String *class_type = Getattr(n, "classtype");
+    String *wasm_name = Getattr(n, "sym:name");
+
+    for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+        String *access = Getattr(c, "access");
+        bool is_virtual = Equal(Getattr(c, "storage"), "virtual");
+        bool is_hidden_field =
+            Equal(nodeType(c), "cdecl") &&
+            Equal(Getattr(c, "kind"), "variable") && access &&
+            !Equal(access, "public") && !Swig_storage_isstatic(c);
+        if (is_virtual || is_hidden_field) {
+            Swig_error(Getfile(n), Getline(n),
+                       "%%wasmsoa cannot be used with %s, which is not a "
+                       "standard layout class.\n",
+                       SwigType_namestr(class_type));
+            return;
+        }
+    }
+
+    String *layout = NewStringEmpty();
+    String *offsets = NewStringEmpty();
+    String *fields = NewStringEmpty();
+    for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+        if (!Equal(nodeType(c), "cdecl") || !Equal(Getattr(c, "kind"), "variable"))
+            continue;
+        String *access = Getattr(c, "access");
+        if ((access && !Equal(access, "public")) || Swig_storage_isstatic(c) ||
+            GetFlag(c, "feature:ignore") || !Getattr(c, "sym:name") ||
+            Getattr(c, "bitfield"))
+            continue;
+
+        SwigType *type = Copy(Getattr(c, "type"));
+        SwigType_push(type, Getattr(c, "decl"));
+        const char *array = typedArrayName(type);
+        Delete(type);
+        int shift = 0;
+        const char *heap = array ? typedArrayHeap(array, &shift) : 0;
+        if (!heap) continue;
+
+        String *field = Getattr(c, "sym:name");
+        Printf(layout, "    offsets.set(\"%s\", offsetof(%s, %s));\n", field,
+               class_type, Getattr(c, "name"));
+
+        String *shift_str = NewStringf("%d", shift);
+        Template offset = getTemplate("emwasm_js_soa_offset");
+        offset.replace("$field", field).replace("$shift", shift_str);
+        Printf(offsets, "        %s\n", offset.trim().str());
+
+        Template accessors = getTemplate("emwasm_js_soa_field");
+        accessors.replace("$field", field)
+            .replace("$heap", heap)
+            .replace("$array", array)
+            .replace("$shift", shift_str);
+        Printf(fields, "%s            %s\n", Len(fields) ? "\n" : "",
+               accessors.trim().str());
+        Delete(shift_str);
+    }
+
+    Template layout_func = getTemplate("emwasm_soa_layout");
+    layout_func.replace("$class_type", class_type)
+        .replace("$wasm_classname", wasm_name)
+        .replace("$fields", layout);
+    Printf(f_extends, "%s\n\n", layout_func.trim().str());
+
+    Template functions = getTemplate("emwasm_soa_layout_functions");
+    functions.replace("$wasm_classname", wasm_name);
+    Printf(f_wrappers, "%s    %s\n", tab4, functions.trim().str());
+
+    Template soa = getTemplate("emwasm_js_soa");
+    soa.replace("$wasm_classname", wasm_name)
+        .replace("$offsets", offsets)
+        .replace("$fields", fields);
+    Printf(f_class_js, "    %s\n\n", soa.trim().str());
+
+    Delete(fields);
+    Delete(offsets);
+    Delete(layout);
+}
+
+/* -----------------------------------------------------------------------------
+ * wrapVectorSoa()
+ *
+ * Adds soa() to a std::vector of a struct with %wasmsoa, returning a
+ * <Struct>SoA viewing the elements of the vector.
+ * -----------------------------------------------------------------------------
+ */
+
+void EmscriptenWasm::wrapVectorSoa(Node *n) {
+    String *name = Getattr(n, "name");
+    if (!SwigType_istemplate(name)) return;
+
+    String *prefix = SwigType_templateprefix(name);
+    bool is_vector = Equal(prefix, "std::vector");
+    Delete(prefix);
+    if (!is_vector) return;
+
+    String *args = SwigType_templateargs(name);
+    String *parms = NewString(Char(args) + 1);
+    List *parmlist = SwigType_parmlist(parms);
+    Node *elem = classLookup(Getitem(parmlist, 0));
+
+    if (elem && GetFlag(elem, "feature:wasm:soa")) {
+        Template data = getTemplate("emwasm_vector_soa");
+        data.replace("$class_type", Getattr(n, "classtype"))
+            .replace("$wasm_classname", Getattr(n, "sym:name"));
+        Printf(f_extends, "%s\n\n", data.trim().str());
+
+        Template functions = getTemplate("emwasm_vector_soa_functions");
+        functions.replace("$wasm_classname", Getattr(n, "sym:name"));
+        Printf(f_wrappers, "%s    %s\n", tab4, functions.trim().str());
+
+        Template soa = getTemplate("emwasm_js_vector_soa");
+        soa.replace("$wasm_classname", Getattr(n, "sym:name"))
+            .replace("$elem_classname", Getattr(elem, "sym:name"));
+        Printf(f_class_js, "    %s\n\n", soa.trim().str());
+    }
+
+    Delete(parmlist);
+    Delete(parms);
+    Delete(args);
+}
+
+/* -----------------------------------------------------------------------------
+ * embindBase()
+ *
+ * Returns the base class given to embind as base<>, which is the first base
+ * class, or 0 if there is none or it is a virtual base, which embind cannot
+ * use as it casts pointers to the base down to the class with a static_cast.
+ * -----------------------------------------------------------------------------
+ */
+
+Node *EmscriptenWasm::embindBase(Node *n) {
+    List *bases = Getattr(n, "bases");
+    if (Len(bases) == 0) return 0;
+    Node *base = Getitem(bases, 0);
+    Hash *virtual_bases = Getattr(n, "virtualbases");
+    if (virtual_bases && Getattr(virtual_bases, Getattr(base, "name")))
+        return 0;
+    return base;
+}
+
+/* -----------------------------------------------------------------------------
+ * wrapSecondaryBases()
+ *
+ * embind classes have a single base, which is the first base class unless
+ * that is a virtual base (see embindBase()).  The member functions and
+ * variables of the other base classes, and of their own bases, are added to
+ * the class itself, through functions which cast the object to the base class
+ * with a static_cast, adjusting the pointer as the compiler would for a call
+ * in C++.  Members whose names are already used by the class or its embind
+ * base are left out, as are members of bases which are also bases of the
+ * embind base.  as<Base>() returns a handle to the base class subobject, to
+ * pass the object where a base is expected.
+ * -----------------------------------------------------------------------------
+ */
+
+void EmscriptenWasm::wrapSecondaryBases(Node *n) {
+    List *bases = Getattr(n, "bases");
+    Node *embind_base = embindBase(n);
+    int first = embind_base ? 1 : 0;
+    if (Len(bases) <= first) return;
+
+    // the names of the members of the class and of its embind base, and the
+    // classes whose members have been added
+    Hash *seen = NewHash();
+    Hash *wrapped = NewHash();
+    List *first_chain = NewList();
+    if (embind_base) {
+        Append(first_chain, embind_base);
+        List *first_bases = Getattr(embind_base, "allbases");
+        for (int i = 0; i < Len(first_bases); i++) {
+            Append(first_chain, Getitem(first_bases, i));
+        }
+    }
+    Append(first_chain, n);
+    for (int i = 0; i < Len(first_chain); i++) {
+        Node *cls = Getitem(first_chain, i);
+        Setattr(wrapped, Getattr(cls, "name"), "1");
+        for (Node *c = firstChild(cls); c; c = nextSibling(c)) {
+            if (Getattr(c, "sym:name")) Setattr(seen, Getattr(c, "sym:name"), "1");
+        }
+    }
+
+    for (int i = first; i < Len(bases); i++) {
+        Node *base = Getitem(bases, i);
+        String *base_name = Getattr(base, "sym:name");
+
+        if (base_name && !GetFlag(base, "feature:ignore")) {
+            Template upcast = getTemplate("emwasm_class_upcast");
+            upcast.replace("$class_type", Getattr(n, "classtype"))
+                .replace("$wasm_classname", Getattr(n, "sym:name"))
+                .replace("$base_type", Getattr(base, "classtype"))
+                .replace("$base_classname", base_name);
+            Printf(f_extends, "%s\n\n", upcast.trim().str());
+
+            Template functions = getTemplate("emwasm_class_upcast_functions");
+            functions.replace("$wasm_classname", Getattr(n, "sym:name"))
+                .replace("$base_classname", base_name);
+            Printf(f_wrappers, "%s    %s\n", tab4, functions.trim().str());
+        }
+
+        List *chain = NewList();
+        Append(chain, base);
+        List *base_bases = Getattr(base, "allbases");
+        for (int j = 0; j < Len(base_bases); j++) {
+            Append(chain, Getitem(base_bases, j));
+        }
+        for (int j = 0; j < Len(chain); j++) {
+            Node *cls = Getitem(chain, j);
+            if (Getattr(wrapped, Getattr(cls, "name"))) continue;
+            Setattr(wrapped, Getattr(cls, "name"), "1");
+            wrapBaseMembers(n, base, cls, seen);
+        }
+        Delete(chain);
+    }
+
+    Delete(first_chain);
+    Delete(wrapped);
+    Delete(seen);
+}
+
+/* -----------------------------------------------------------------------------
+ * wrapBaseMembers()
+ *
+ * Adds the members of cls, which is base or one of its bases, to n.  Member
+ * variables are wrapped like those of n itself, through thunks.  Member
+ * functions are called through thunks taking the object as first argument,
+ * whose types are fully qualified as they are declared outside of any class
+ * or namespace.  embind only overloads by number of arguments, so an overload
+ * with as many arguments as one already added is left out with a warning.
+ * -----------------------------------------------------------------------------
+ */
+
+void EmscriptenWasm::wrapBaseMembers(Node *n, Node *base, Node *cls, Hash *seen) {
+    String *class_type = Getattr(n, "classtype");
+    String *wasm_class = Getattr(n, "sym:name");
+    String *cls_type = Getattr(cls, "classtype");
+    // cast through base, as cls may be a base of other bases too
+    String *cast, *const_cast_;
+    if (base == cls) {
+        cast = NewStringf("static_cast<%s&>(self)", cls_type);
+        const_cast_ = NewStringf("static_cast<const %s&>(self)", cls_type);
+    } else {
+        String *base_type = Getattr(base, "classtype");
+        cast = NewStringf("static_cast<%s&>(static_cast<%s&>(self))",
+                          cls_type, base_type);
+        const_cast_ = NewStringf(
+            "static_cast<const %s&>(static_cast<const %s&>(self))", cls_type,
+            base_type);
+    }
+
+    // the names added from cls, each with the functions added under it by
+    // number of arguments, as embind only overloads by arity
+    Hash *added = NewHash();
+    for (Node *c = firstChild(cls); c; c = nextSibling(c)) {
+        String *name = Getattr(c, "sym:name");
+        String *access = Getattr(c, "access");
+        String *kind = Getattr(c, "kind");
+        if (!Equal(nodeType(c), "cdecl") || !name ||
+            (access && !Equal(access, "public")) || Swig_storage_isstatic(c) ||
+            GetFlag(c, "feature:ignore") || Getattr(c, "template") ||
+            Strncmp(Getattr(c, "name"), "operator ", 9) == 0)
+            continue;
+        if (Getattr(seen, name) && !Getattr(added, name)) continue;
+
+        String *thunk = NewStringf("__%s_%s_%s", wasm_class,
+                                   Getattr(cls, "sym:name"), name);
+        if (Equal(kind, "function")) {
+            ParmList *parms = Getattr(c, "parms");
+            Hash *arities = Getattr(added, name);
+            String *arity = NewStringf("%d", ParmList_len(parms));
+            bool varargs = false;
+            for (Parm *p = parms; p; p = nextSibling(p)) {
+                if (SwigType_isvarargs(Getattr(p, "type"))) varargs = true;
+            }
+            if (varargs) {
+                Swig_warning(WARN_LANG_VARARGS, Getfile(c), Getline(c),
+                             "%s not added to %s, as it has variable length arguments.\n",
+                             Swig_name_decl(c), wasm_class);
+                Delete(arity);
+                Delete(thunk);
+                continue;
+            }
+            if (arities && Getattr(arities, arity)) {
+                Swig_warning(WARN_LANG_OVERLOAD_IGNORED, Getfile(c), Getline(c),
+                             "Overloaded method %s not added to %s,\n",
+                             Swig_name_decl(c), wasm_class);
+                Swig_warning(WARN_LANG_OVERLOAD_IGNORED,
+                             Getfile(Getattr(arities, arity)),
+                             Getline(Getattr(arities, arity)),
+                             "using %s instead.\n",
+                             Swig_name_decl(Getattr(arities, arity)));
+                Delete(arity);
+                Delete(thunk);
+                continue;
+            }
+
+            SwigType *decl = Copy(Getattr(c, "decl"));
+            Delete(SwigType_pop_function(decl));
+            SwigType *rtype = Copy(Getattr(c, "type"));
+            SwigType_push(rtype, decl);
+            SwigType *resolved_rtype = SwigType_typedef_resolve_all(rtype);
+            bool is_const = SwigType_isconst(Getattr(c, "qualifier"));
+
+            String *params = NewStringEmpty();
+            String *args = NewStringEmpty();
+            int argnum = 0;
+            for (Parm *p = parms; p; p = nextSibling(p), argnum++) {
+                String *arg = NewStringf("arg%d", argnum);
+                SwigType *ptype = SwigType_typedef_resolve_all(Getattr(p, "type"));
+                String *pstr = SwigType_str(ptype, arg);
+                Printf(params, ", %s", pstr);
+                Printf(args, "%s%s", argnum ? ", " : "", arg);
+                Delete(pstr);
+                Delete(ptype);
+                Delete(arg);
+            }
+            Printf(thunk, "_%d", ParmList_len(parms));
+            String *rstr = SwigType_str(resolved_rtype, 0);
+            Printf(f_extends, "%s %s(%s%s& self%s) {\n"
+                   "    return %s.%s(%s);\n}\n\n",
+                   rstr, thunk, is_const ? "const " : "", class_type, params,
+                   is_const ? const_cast_ : cast, Getattr(c, "name"), args);
+
+            String *fname = Copy(thunk);
+            if (checkHasRawPointer(rtype, parms)) {
+                Append(fname, ", allow_raw_pointers()");
+            }
+            Template func = getTemplate("emwasm_function");
+            func.replace("$name", name).replace("$func", fname);
+            Printf(f_wrappers, "        .%s\n", func.trim().str());
+
+            if (!arities) {
+                arities = NewHash();
+                Setattr(added, name, arities);
+                Delete(arities);
+            }
+            Setattr(arities, arity, c);
+            Delete(fname);
+            Delete(rstr);
+            Delete(args);
+            Delete(params);
+            Delete(resolved_rtype);
+            Delete(rtype);
+            Delete(decl);
+            Delete(arity);
+        } else if (Equal(kind, "variable") && !Getattr(added, name)) {
+            // the type of a member is only merged with its declarator while
+            // the member is being wrapped
+            SwigType *type = Getattr(c, "type");
+            SwigType *full_type = Copy(type);
+            SwigType_push(full_type, Getattr(c, "decl"));
+            if (SwigType_isarray(full_type) || SwigType_isreference(full_type)) {
+                String *tstr = SwigType_str(full_type, 0);
+                Swig_warning(WARN_TYPEMAP_VAR_UNDEF, Getfile(c), Getline(c),
+                             "Unsupported member variable type %s of %s not added to %s.\n",
+                             tstr, Swig_name_decl(c), wasm_class);
+                Delete(tstr);
+                Delete(full_type);
+                Delete(thunk);
+                continue;
+            }
+            String *decl = Getattr(c, "decl");
+            DohIncref(type);
+            DohIncref(decl);
+            Setattr(c, "type", full_type);
+            Delattr(c, "decl");
+            wrapMemberVariable(c, thunk, cast, const_cast_);
+            Setattr(c, "type", type);
+            Setattr(c, "decl", decl);
+            Delete(decl);
+            Delete(type);
+            Delete(full_type);
+
+            Hash *none = NewHash();
+            Setattr(added, name, none);
+            Delete(none);
+        }
+        Delete(thunk);
+    }
+
+    for (Iterator it = First(added); it.key; it = Next(it)) {
+        Setattr(seen, it.key, "1");
+    }
+    Delete(added);
+    Delete(const_cast_);
+    Delete(cast);
+}
+
+/* -----------------------------------------------------------------------------
+ * referenceMemberClass()
+ *
+ * The wrapped class of a member variable which is an object of that class, or
+ * a pointer to one, and is read through a reference rather than copied, or 0.
+ * %wasmcopy makes a member be copied instead.
+ * -----------------------------------------------------------------------------
+ */
+
+SwigType *EmscriptenWasm::referenceMemberClass(Node *n) {
+    if (GetFlag(n, "feature:wasm:copy")) return 0;
+
+    // the declarator is only merged into the type while n is being wrapped
+    SwigType *full_type = Copy(Getattr(n, "type"));
+    if (Getattr(n, "decl")) SwigType_push(full_type, Getattr(n, "decl"));
+    SwigType *type = SwigType_typedef_resolve_all(full_type);
+    Delete(full_type);
+    if (SwigType_ispointer(type)) {
+        SwigType_del_pointer(type);
+    }
+    SwigType *stripped = SwigType_strip_qualifiers(type);
+    Delete(type);
+
+    Node *cls = 0;
+    if (SwigType_type(stripped) == T_USER) {
+        cls = classLookup(stripped);
+    }
+    if (!cls) {
+        Delete(stripped);
+        return 0;
+    }
+    return stripped;
+}
+
+/* -----------------------------------------------------------------------------
+ * markReferencedClasses()
+ *
+ * Flags with wasm:shared the classes of the member variables which are read
+ * by reference, before any class is wrapped, as only these classes, and
+ * pooled ones, register the std::shared_ptr handles the getters return.
+ * -----------------------------------------------------------------------------
+ */
+
+void EmscriptenWasm::markReferencedClasses(Node *n) {
+    for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+        if (Equal(nodeType(c), "template")) continue;
+        if (Equal(nodeType(c), "cdecl") && Equal(Getattr(c, "kind"), "variable")) {
+            String *access = Getattr(c, "access");
+            if (!Equal(nodeType(n), "class") ||
+                (access && !Equal(access, "public")) || Swig_storage_isstatic(c) ||
+                GetFlag(c, "feature:ignore"))
+                continue;
+            SwigType *member_class = referenceMemberClass(c);
+            if (member_class) {
+                SetFlag(classLookup(member_class), "wasm:shared");
+                Delete(member_class);
+            }
+        } else {
+            markReferencedClasses(c);
+        }
+    }
+}
+
+/* -----------------------------------------------------------------------------
+ * generateReferenceGetterFunction()
+ *
+ * Emits a getter returning a std::shared_ptr which shares no ownership, so
+ * that the handle refers to the member itself.  Deleting the handle does not
+ * delete the member, and the handle must not be used after the object
+ * containing the member has been deleted.
+ * -----------------------------------------------------------------------------
+ */
+
+String *EmscriptenWasm::generateReferenceGetterFunction(Node *n,
+                                                        SwigType *member_class,
+                                                        const String *func_name,
+                                                        const String *self) {
+    Node *classn = getCurrentClass();
+    String *cls_name = Getattr(classn, "sym:name");
+    String *class_type = Getattr(classn, "classtype");
+    String *member_type = SwigType_str(member_class, 0);
+    bool is_pointer = checkHasRawPointer(Getattr(n, "type"), 0);
+
+    String *getter = func_name ? NewString(func_name)
+                               : NewStringf("__%s_get_%s", cls_name,
+                                            Getattr(n, "sym:name"));
+    if (!self) self = "self";
+    Printf(f_extends, "std::shared_ptr<%s> %s(const %s& self) {\n"
+           "    return std::shared_ptr<%s>(std::shared_ptr<%s>(), "
+           "const_cast<%s *>(%s%s.%s));\n}\n\n",
+           member_type, getter, class_type,
+           member_type, member_type,
+           member_type, is_pointer ? "" : "&", self, Getattr(n, "name"));
+
+    Delete(member_type);
+    return getter;
 }
-String *EmscriptenWasm::generateSetterFunction(Node *n) {
+
+/* -----------------------------------------------------------------------------
+ * generateSetterFunction()
+ *
+ * Emits a setter for member variable n of the current class, named func_name
+ * or __<class>_set_<member>, which assigns to the member of the expression
+ * self, "self" by default.  A pointer member has the value it points to
+ * assigned.
+ * -----------------------------------------------------------------------------
+ */
+
+String *EmscriptenWasm::generateSetterFunction(Node *n, const String *func_name,
+                                               const String *self) {
     Node *classn = getCurrentClass();
     String* cls_name = Getattr(classn, "sym:name");
     String *pname = Getattr(n, "sym:name");
-    SwigType* type = Copy(Getattr(n, "type"));
+    SwigType* type = SwigType_typedef_resolve_all(Getattr(n, "type"));
 
     bool is_pointer = checkHasRawPointer(type, 0);
     if (is_pointer) {
@@ -783,24 +2081,178 @@ String *EmscriptenWasm::generateSetterFunction(Node *n) {
     }
     String *class_type = Getattr(classn, "classtype");
 
-    String *func_name = NewStringEmpty();
-    Printf(func_name, "__%s_set_%s", cls_name, pname);
+    String *setter = func_name ? NewString(func_name)
+                               : NewStringf("__%s_set_%s", cls_name, pname);
+    if (!self) self = "self";
+    String *tstr = SwigType_str(type, 0);
     // fixme: empty pointer
-    Printf(f_extends, "void %s(const %s& self, const %s& val) {\n"
-           "    %s(self.%s) = val;\n}\n\n",
-           func_name, class_type, SwigType_str(type, 0),
-           is_pointer ? "*" :"", Getattr(n, "name")
+    Printf(f_extends, "void %s(%s& self, const %s& value) {\n"
+           "    %s(%s.%s) = value;\n}\n\n",
+           setter, class_type, tstr,
+           is_pointer ? "*" :"", self, Getattr(n, "name")
           );
 
+    Delete(tstr);
     Delete(type);
-    return func_name;
+    return setter;
 }
 
+/* -----------------------------------------------------------------------------
+ * generateOverloadedFunctionShadowCode()
+ *
+ * Emits the JS dispatcher for the overload set starting at n.  The overloads
+ * are grouped by number of arguments with a switch on arguments.length.  An
+ * arity with a single overload calls it directly; otherwise only the argument
+ * positions whose type checks differ between the overloads are tested, in
+ * declaration order, except that an overload taking derived classes is tried
+ * before one taking their bases.  Objects are checked with instanceof, so
+ * that objects of derived classes match, against the class constructor,
+ * which is looked up once when the dispatcher is created.
+ * -----------------------------------------------------------------------------
+ */
+
 String *EmscriptenWasm::generateOverloadedFunctionShadowCode(Node *n) {
-    if (!Getattr(n, "sym:overloaded") || GetFlag(n, "__wasm_wraped")) {
-        return 0;
+    Node *classn = getCurrentClass();
+    String *wasm_fname = Getattr(n, "sym:name");
+    int isstatic = classn && Swig_storage_isstatic(n) &&
+                   !(SmartPointer && Getattr(n, "allocate:smartpointeraccess"));
+
+    // overloads by number of arguments
+    Hash *arities = NewHash();
+    int max_arity = 0;
+    for (Node *nod = n; nod; nod = Getattr(nod, "sym:nextSibling")) {
+        if (GetFlag(nod, "__wasm_wraped")) continue;
+        int arity = ParmList_len(Getattr(nod, "parms"));
+        String *key = NewStringf("%d", arity);
+        List *candidates = Getattr(arities, key);
+        if (!candidates) {
+            candidates = NewList();
+            Setattr(arities, key, candidates);
+            Delete(candidates);
+        }
+        int at = Len(candidates);
+        for (int i = 0; i < Len(candidates); i++) {
+            if (isOverloadMoreDerived(nod, Getitem(candidates, i))) {
+                at = i;
+                break;
+            }
+        }
+        Insert(candidates, at, nod);
+        if (arity > max_arity) max_arity = arity;
+        Delete(key);
     }
 
+    Hash *classrefs = NewHash();
+    String *classdecls = NewStringEmpty();
+    String *cases = NewStringEmpty();
+    for (int arity = 0; arity <= max_arity; arity++) {
+        String *key = NewStringf("%d", arity);
+        List *candidates = Getattr(arities, key);
+        Delete(key);
+        if (!candidates) continue;
+
+        int ncandidates = Len(candidates);
+        Printf(cases, "            case %d:\n", arity);
+
+        // the type checks of each candidate, by argument position
+        List *checks = NewList();
+        for (int i = 0; ncandidates > 1 && i < ncandidates; i++) {
+            List *cand_checks = NewList();
+            int pos = 0;
+            for (Parm *p = Getattr(Getitem(candidates, i), "parms"); p;
+                 p = nextSibling(p), pos++) {
+                String *arg = NewStringf("a%d", pos);
+                String *check = jsTypeCheck(Getattr(p, "type"), arg,
+                                            classrefs, classdecls);
+                Append(cand_checks, check);
+                Delete(check);
+                Delete(arg);
+            }
+            Append(checks, cand_checks);
+            Delete(cand_checks);
+        }
+
+        for (int i = 0; i < ncandidates; i++) {
+            Node *cand = Getitem(candidates, i);
+            String *cond = NewStringEmpty();
+
+            if (ncandidates > 1) {
+                List *cand_checks = Getitem(checks, i);
+                for (int pos = 0; pos < arity; pos++) {
+                    String *check = Getitem(cand_checks, pos);
+                    bool discriminates = false;
+                    for (int j = 0; j < ncandidates; j++) {
+                        if (!Equal(Getitem(Getitem(checks, j), pos), check)) {
+                            discriminates = true;
+                            break;
+                        }
+                    }
+                    if (discriminates) {
+                        Printf(cond, "%s%s", Len(cond) ? " && " : "", check);
+                    }
+                }
+            }
+
+            String *target = overloadedFunctionTarget(cand);
+            String *args = NewStringEmpty();
+            for (int pos = 0; pos < arity; pos++) {
+                Printf(args, "%sa%d", pos ? ", " : "", pos);
+            }
+            if (Len(cond)) {
+                Printf(cases, "                if (%s)\n    ", cond);
+            }
+            Printf(cases, "                return %s(%s);\n", target, args);
+
+            SetFlag(cand, "__wasm_wraped");
+            Delete(args);
+            Delete(target);
+            Delete(cond);
+        }
+        if (ncandidates > 1) {
+            Printf(cases, "                break;\n");
+        }
+        Delete(checks);
+    }
+
+    String *dispatcher_params = NewStringEmpty();
+    for (int pos = 0; pos < max_arity; pos++) {
+        Printf(dispatcher_params, "%sa%d", pos ? ", " : "", pos);
+    }
+
+    if (classn) {
+        String *wasm_cname = Getattr(classn, "sym:name");
+        if (isstatic) {
+            Printf(f_overload_js, "    Module['%s'].%s = (function () {\n",
+                   wasm_cname, wasm_fname);
+        } else {
+            Printf(f_overload_js,
+                   "    Module['%s'].prototype['%s'] = (function () {\n",
+                   wasm_cname, wasm_fname);
+        }
+    } else {
+        Printf(f_overload_js, "    Module.%s = (function () {\n", wasm_fname);
+    }
+    Printf(f_overload_js, "%s", classdecls);
+    Printf(f_overload_js, "        return function (%s) {\n",
+           dispatcher_params);
+    Printf(f_overload_js, "            switch (arguments.length) {\n%s",
+           cases);
+    Printf(f_overload_js, "            }\n");
+    Printf(f_overload_js,
+           "            throw('Arguments are illegal! No overloaded function "
+           "was matched!');\n");
+    Printf(f_overload_js, "        };\n    })();\n\n");
+
+    Delete(dispatcher_params);
+    Delete(cases);
+    Delete(classdecls);
+    Delete(classrefs);
+    Delete(arities);
+    return 0;
+}
+
+/* The JS expression calling the wrapper of one overload. */
+String *EmscriptenWasm::overloadedFunctionTarget(Node *n) {
     int isstatic = getCurrentClass() && Swig_storage_isstatic(n) &&
                    !(SmartPointer && Getattr(n, "allocate:smartpointeraccess"));
 
@@ -818,24 +2270,121 @@ String *EmscriptenWasm::generateOverloadedFunctionShadowCode(Node *n) {
     } else {
         Insert(wasm_name, 0, "Module.");
     }
-    selectOverloadedFuntionShadowCode(wasm_name, Getattr(n, "parms"));
+    return wasm_name;
+}
 
-    SetFlag(n, "__wasm_wraped");
-    return 0;
+/* -----------------------------------------------------------------------------
+ * jsTypeCheck()
+ *
+ * Returns a JS expression testing whether arg can be passed as type.  Numbers
+ * may also be given as enum values, which are objects with a numeric value.
+ * Wrapped classes are tested by constructor; the constructor is bound to a
+ * local in classdecls the first time a class is used.
+ * -----------------------------------------------------------------------------
+ */
+
+/* Whether overload a takes an object of a class derived from the class which
+   overload b takes at some position, and the same types at the others, so
+   that an object matching a also matches b. */
+bool EmscriptenWasm::isOverloadMoreDerived(Node *a, Node *b) {
+    bool derived = false;
+    Parm *pb = Getattr(b, "parms");
+    for (Parm *pa = Getattr(a, "parms"); pa && pb;
+         pa = nextSibling(pa), pb = nextSibling(pb)) {
+        SwigType *ta = Getattr(pa, "type");
+        SwigType *tb = Getattr(pb, "type");
+        if (Equal(ta, tb)) continue;
+        Node *ca = classLookup(ta);
+        Node *cb = classLookup(tb);
+        List *bases = ca ? Getattr(ca, "allbases") : 0;
+        bool found = false;
+        for (int i = 0; cb && i < Len(bases); i++) {
+            if (Getitem(bases, i) == cb) found = true;
+        }
+        if (!found) return false;
+        derived = true;
+    }
+    return derived;
 }
 
-String *EmscriptenWasm::selectOverloadedFuntionShadowCode(String *sym_funcname,
-                                                          ParmList *plist) {
-    // int plen = Len(plist);
-    // String *js_check_code = NewStringEmpty();
-    String *type_arr = parmsToJsTypeStrArray(plist);
+String *EmscriptenWasm::jsTypeCheck(SwigType *st, const String *arg,
+                                    Hash *classrefs, String *classdecls) {
+    String *check = NewStringEmpty();
+    SwigType *st_resolve = SwigType_typedef_resolve_all(st);
+    SwigType *type = SwigType_base(st_resolve);
+    SwigType *base = SwigType_base(st);
+    String *type_str = SwigType_str(base, 0);
+    Delete(base);
+
+    // SwigType_base() strips the pointer from char *, so strings are told
+    // apart from char, which embind registers as an integer, beforehand.
+    int type_code = SwigType_type(st_resolve);
+    if (type_code != T_STRING && type_code != T_WSTRING)
+        type_code = SwigType_type(type);
+
+    switch (type_code) {
+        case T_STRING:
+        case T_WSTRING:
+            Printf(check, "typeof %s === 'string'", arg);
+            break;
+        case T_CHAR:
+        case T_WCHAR:
+        case T_INT:
+        case T_UINT:
+        case T_SHORT:
+        case T_USHORT:
+        case T_LONG:
+        case T_ULONG:
+        case T_LONGLONG:
+        case T_ULONGLONG:
+        case T_SCHAR:
+        case T_UCHAR:
+            Printf(check,
+                   "(typeof %s === 'number' ? Number.isInteger(%s) : "
+                   "%s != null && Number.isInteger(%s.value))",
+                   arg, arg, arg, arg);
+            break;
+        case T_FLOAT:
+        case T_DOUBLE:
+        case T_LONGDOUBLE:
+        case T_NUMERIC:
+            Printf(check,
+                   "(typeof %s === 'number' || "
+                   "%s != null && typeof %s.value === 'number')",
+                   arg, arg, arg);
+            break;
+        case T_BOOL:
+            Printf(check, "typeof %s === 'boolean'", arg);
+            break;
+        default: {
+            Node *cls = classLookup(st);
+            if (Equal(type_str, "std::string") ||
+                Equal(type_str, "std::wstring")) {
+                Printf(check, "typeof %s === 'string'", arg);
+            } else if (cls && Getattr(cls, "sym:name")) {
+                String *cname = Getattr(cls, "sym:name");
+                String *ref = Getattr(classrefs, cname);
+                if (!ref) {
+                    ref = NewStringf("__c%d", Len(classrefs));
+                    Setattr(classrefs, cname, ref);
+                    Printf(classdecls, "        const %s = Module['%s'];\n",
+                           ref, cname);
+                    Delete(ref);
+                    ref = Getattr(classrefs, cname);
+                }
+                Printf(check, "%s instanceof %s", arg, ref);
+            } else {
+                Printf(check, "%s != null && %s.constructor.__type === \"%s\"",
+                       arg, arg, type_str);
+            }
+            break;
+        }
+    }
 
-    Printf(f_overload_js, "        if (__check_arguments(arguments, %s)) {\n",
-           type_arr);
-    Printf(f_overload_js, "%s%s    return %s(...arguments);\n        }\n", tab4,
-           tab4, sym_funcname);
-    Delete(type_arr);
-    return 0;
+    Delete(type_str);
+    Delete(type);
+    Delete(st_resolve);
+    return check;
 }
 
 bool EmscriptenWasm::checkHasRawPointer(SwigType *return_type,
@@ -927,69 +2476,6 @@ String *EmscriptenWasm::paramsToStr(ParmList *p, int t) {
     return out;
 }
 
-String *EmscriptenWasm::parmsToJsTypeStrArray(ParmList *plist) {
-    if (!plist || Len(plist) == 0) {
-        return NewString("[]");
-    }
-
-    String *arr_str = NewString("[");
-    ParmList *p = plist;
-
-    while (p) {
-        SwigType *st_resolve = 0;
-        SwigType *st = Getattr(p, "type");
-        if (st) st_resolve = SwigType_typedef_resolve(st);
-        SwigType *type = SwigType_base(st_resolve ? st_resolve : st);
-
-        switch (SwigType_type(type)) {
-            case T_STRING:
-            case T_WSTRING:
-                Append(arr_str, "\"string\"");
-                break;
-            case T_INT:
-            case T_UINT:
-            case T_SHORT:
-            case T_USHORT:
-            case T_LONG:
-            case T_ULONG:
-            case T_LONGLONG:
-            case T_ULONGLONG:
-                Append(arr_str, "\"int\"");
-                break;
-            case T_FLOAT:
-            case T_DOUBLE:
-            case T_LONGDOUBLE:
-            case T_NUMERIC:
-                Append(arr_str, "\"float\"");
-                break;
-            case T_FLTCPLX:
-            case T_DBLCPLX:
-                Append(arr_str, "\"complex\"");
-                break;
-            case T_CHAR:
-            case T_WCHAR:
-                Append(arr_str, "\"char\"");
-                break;
-            case T_BOOL:
-                Append(arr_str, "\"boolean\"");
-                break;
-            case T_USER:
-            default:
-                Printf(arr_str, "\"%s\"",
-                       SwigType_str(type ? type : NewStringEmpty(), 0));
-                break;
-        }
-
-        p = nextSibling(p);
-        if (p) {
-            Append(arr_str, ",");
-        }
-    }
-    Append(arr_str, "]");
-
-    return arr_str;
-}
-
 /* -----------------------------------------------------------------------------
  * Template::Template() :  creates a Template class for given template code
  * -----------------------------------------------------------------------------
@@ -1000,8 +2486,11 @@ Template::Template(const String *code_) {
         Printf(stdout, "Template code was null. Illegal input for template.");
         SWIG_exit(EXIT_FAILURE);
     }
-    code = NewString(code_);
+    segments = compile(code_);
+    values = NewHash();
+    code = 0;
     templateName = NewString("");
+    trimmed = false;
 }
 
 Template::Template(const String *code_, const String *templateName_) {
@@ -1010,8 +2499,20 @@ Template::Template(const String *code_, const String *templateName_) {
         SWIG_exit(EXIT_FAILURE);
     }
 
-    code = NewString(code_);
+    segments = compile(code_);
+    values = NewHash();
+    code = 0;
     templateName = NewString(templateName_);
+    trimmed = false;
+}
+
+Template::Template(List *segments_, const String *templateName_) {
+    segments = segments_;
+    DohIncref(segments);
+    values = NewHash();
+    code = 0;
+    templateName = NewString(templateName_);
+    trimmed = false;
 }
 
 /* -----------------------------------------------------------------------------
@@ -1020,53 +2521,121 @@ Template::Template(const String *code_, const String *templateName_) {
  */
 
 Template::~Template() {
+    Delete(segments);
+    Delete(values);
     Delete(code);
     Delete(templateName);
 }
 
+/* -----------------------------------------------------------------------------
+ * List* Template::compile() :  splits template code into segments.
+ *
+ * The list starts with literal text, and placeholders and literal text
+ * alternate after that.  A '$' not followed by an identifier character is
+ * literal text.
+ * -----------------------------------------------------------------------------
+ */
+
+List *Template::compile(const String *code) {
+    List *segments = NewList();
+    const char *str = Char(code);
+    String *literal = NewStringEmpty();
+
+    while (*str) {
+        const char *end = str + 1;
+        if (*str == '$') {
+            while (isalnum((unsigned char)*end) || *end == '_') end++;
+        }
+        if (*str != '$' || end == str + 1) {
+            const char *dollar = strchr(end, '$');
+            if (!dollar) dollar = end + strlen(end);
+            Write(literal, str, (int)(dollar - str));
+            str = dollar;
+            continue;
+        }
+        Append(segments, literal);
+        Delete(literal);
+        String *placeholder = NewStringWithSize(str, (int)(end - str));
+        Append(segments, placeholder);
+        Delete(placeholder);
+        literal = NewStringEmpty();
+        str = end;
+    }
+    Append(segments, literal);
+    Delete(literal);
+    return segments;
+}
+
 /* -----------------------------------------------------------------------------
  * String* Template::str() :  retrieves the current content of the template.
  * -----------------------------------------------------------------------------
  */
 
-String *Template::str() { return code; }
+String *Template::str() {
+    if (!code) render();
+    return code;
+}
 
-Template &Template::trim() {
-    const char *str = Char(code);
-    if (str == 0) return *this;
+/* -----------------------------------------------------------------------------
+ * Template::render() :  renders the segments with the values replaced.
+ *
+ * A placeholder takes the value of the longest pattern that it starts with,
+ * followed by the rest of the placeholder, so that $wasm_classname_view is
+ * rendered with the value of $wasm_classname.
+ * -----------------------------------------------------------------------------
+ */
 
-    int length = Len(code);
-    if (length == 0) return *this;
+void Template::render() {
+    code = NewStringEmpty();
+    int nsegments = Len(segments);
+    for (int i = 0; i < nsegments; i++) {
+        String *segment = Getitem(segments, i);
+        if (i % 2 == 0) {
+            Append(code, segment);
+            continue;
+        }
 
-    int idx;
-    for (idx = 0; idx < length; ++idx) {
-        if (str[idx] != ' ' && str[idx] != '\t' && str[idx] != '\r' &&
-            str[idx] != '\n')
-            break;
+        String *value = 0;
+        int matched = 0;
+        for (Iterator it = First(values); it.key; it = Next(it)) {
+            int len = Len(it.key);
+            if (len > matched && Strncmp(segment, it.key, len) == 0) {
+                value = it.item;
+                matched = len;
+            }
+        }
+        if (value) {
+            Append(code, value);
+            Append(code, Char(segment) + matched);
+        } else {
+            Append(code, segment);
+        }
     }
-    int start_pos = idx;
 
-    for (idx = length - 1; idx >= start_pos; --idx) {
-        if (str[idx] != ' ' && str[idx] != '\t' && str[idx] != '\r' &&
-            str[idx] != '\n')
-            break;
+    if (trimmed) {
+        const char *str = Char(code);
+        int length = Len(code);
+        int end = length;
+        while (end > 0 && isspace((unsigned char)str[end - 1])) end--;
+        if (end < length) Delslice(code, end, length);
+        str = Char(code);
+        int start = 0;
+        while (start < end && isspace((unsigned char)str[start])) start++;
+        if (start > 0) Delslice(code, 0, start);
     }
-    int end_pos = idx;
-
-    int new_length = end_pos - start_pos + 1;
-    char *newstr = new char[new_length + 1];
-    memcpy(newstr, str + start_pos, new_length);
-    newstr[new_length] = 0;
+}
 
+Template &Template::trim() {
+    trimmed = true;
     Delete(code);
-    code = NewString(newstr);
-    delete[] newstr;
-
+    code = 0;
     return *this;
 }
 
 Template &Template::replace(const String *pattern, const String *repl) {
-    Replaceall(code, pattern, repl);
+    Setattr(values, pattern, repl);
+    Delete(code);
+    code = 0;
     return *this;
 }
 
@@ -1081,15 +2650,25 @@ Template &Template::pretty_print(DOH *doh) {
 }
 
 Template::Template(const Template &t) {
-    code = NewString(t.code);
+    segments = t.segments;
+    DohIncref(segments);
+    values = Copy(t.values);
+    code = 0;
     templateName = NewString(t.templateName);
+    trimmed = t.trimmed;
 }
 
 void Template::operator=(const Template &t) {
+    DohIncref(t.segments);
+    Delete(segments);
+    Delete(values);
     Delete(code);
     Delete(templateName);
-    code = NewString(t.code);
+    segments = t.segments;
+    values = Copy(t.values);
+    code = 0;
     templateName = NewString(t.templateName);
+    trimmed = t.trimmed;
 }
 }  // namespace wasm
 
@@ -363,6 +363,7 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern String *Swig_cfunction_call(const_String_or_char_ptr name, ParmList *parms);
   extern String *Swig_cconstructor_call(const_String_or_char_ptr name);
   extern String *Swig_cppconstructor_call(const_String_or_char_ptr name, ParmList *parms);
+  extern String *Swig_cppconstructor_nodirector_call(const_String_or_char_ptr name, ParmList *parms);
   extern String *Swig_unref_call(Node *n);
   extern String *Swig_ref_call(Node *n, const String *lname);
   extern String *Swig_cdestructor_call(Node *n);